@@ -0,0 +1,69 @@
+#!/bin/sh
+#---------------------------------------------------------------------
+# Assignment : PA-02 Concurrent Processes & IPC
+# Date       : 10/25/25
+# Author     : Aiden Smith and Braden Drake
+#---------------------------------------------------------------------
+# Pipeline benchmark: runs Sales over every combination of factory
+# count, order size and IPC backend, with batch durations scaled by
+# TIME_SCALE (0 = no sleeping at all), and prints one CSV row per run.
+# Metrics come from the supervisor's final report:
+#   wall_ms          Sales start to exit
+#   parts_per_s      order size / wall time
+#   msgs_per_s       messages the supervisor received / wall time
+#   sem_waits        times anyone blocked on sem_shm or sem_log
+#   p50_us, p99_us   factory-queued to supervisor-received latency
+#
+# A backend is "<claim>/<transport>": sem/msgq is the original
+# semaphore + System V queue pipeline. With JSON=<file> the same
+# rows are also written there as a JSON array.
+#
+# Usage: ./bench.sh [extra sales options...]
+#---------------------------------------------------------------------
+
+FACTORIES=${FACTORIES:-"1 10 100"}
+ORDERS=${ORDERS:-"1000 10000"}
+BACKENDS=${BACKENDS:-"sem/msgq atomic/msgq atomic/ring steal/ring"}
+MODES=${MODES:-"process threads"}
+TIME_SCALE=${TIME_SCALE:-0}
+
+[ -n "$JSON" ] && echo "[" > "$JSON"
+sep=""
+
+echo "mode,backend,factories,order_size,time_scale,wall_ms,parts_per_s,msgs_per_s,sem_waits,p50_us,p99_us,grand_total"
+for n in $FACTORIES; do
+  for order in $ORDERS; do
+    for backend in $BACKENDS; do
+      for mode in $MODES; do
+        flags="--claim ${backend%/*} --transport ${backend#*/} --time-scale $TIME_SCALE $*"
+        [ "$mode" = threads ] && flags="$flags --threads"
+
+        rm -f factory.log
+        start=$(date +%s%N)
+        ./sales $flags "$n" "$order" > /dev/null || exit 1
+        end=$(date +%s%N)
+        wall_us=$(( (end - start) / 1000 ))
+        [ "$wall_us" -gt 0 ] || wall_us=1
+
+        grand=$(sed -n 's/^Grand total parts made = *\([0-9]*\).*/\1/p' supervisor.log)
+        read msgs p50 p99 waits <<END
+$(sed -n 's/^Messages = *\([0-9]*\) *latency p50 = *\([0-9.]*\) us *p99 = *\([0-9.]*\) us *Semaphore waits = *\([0-9]*\).*/\1 \2 \3 \4/p' supervisor.log)
+END
+
+        row="$mode,$backend,$n,$order,$TIME_SCALE,$((wall_us / 1000)),$((order * 1000000 / wall_us)),$((msgs * 1000000 / wall_us)),$waits,$p50,$p99,$grand"
+        echo "$row"
+
+        if [ -n "$JSON" ]; then
+          echo "$row" | awk -F, -v sep="$sep" '{
+            printf "%s  {\"mode\": \"%s\", \"backend\": \"%s\", \"factories\": %s, \"order_size\": %s, \"time_scale\": %s, ", sep, $1, $2, $3, $4, $5
+            printf "\"wall_ms\": %s, \"parts_per_s\": %s, \"msgs_per_s\": %s, \"sem_waits\": %s, \"p50_us\": %s, \"p99_us\": %s, \"grand_total\": %s}", $6, $7, $8, $9, $10, $11, $12
+          }' >> "$JSON"
+          sep=",\n"
+        fi
+      done
+    done
+  done
+done
+
+[ -n "$JSON" ] && printf "\n]\n" >> "$JSON"
+exit 0
@@ -0,0 +1,103 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+// Contention benchmark for the part-claiming paths.
+// Forks <procs> claimers that drain an order of <parts> parts in
+// batches of <capacity> with no sleeping, once with the sem_shm
+// critical section, once with the lock-free CAS path and once with
+// per-claimer reservations and stealing.
+//----------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/wait.h>
+#include <semaphore.h>
+
+#include "wrappers.h"
+#include "shmem.h"
+#include "claim.h"
+
+#define SEM_BENCH_NAME  "/Team25_bench_mutex"
+
+// Monotonic clock in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Runs one round with every claimer using the given mode
+static void run_round(int mode, int procs, int parts, int capacity) {
+    int shmid = Shmget(IPC_PRIVATE, shmemSize(procs), IPC_CREAT | S_IRUSR | S_IWUSR);
+    shData *shm = (shData*)Shmat(shmid, NULL, 0);
+    sem_t *sem_shm = Sem_open(SEM_BENCH_NAME, O_CREAT | O_EXCL, S_IRUSR | S_IWUSR, 1);
+
+    shmemInit(shm, procs);
+    shm->activeFactories = procs;
+    shm->claimMode = mode;
+    openOrder(shm, 1, parts, NO_DEADLINE);
+
+    // Every claim but the last takes a full batch, so the claim
+    // count is known up front as ceil(parts / capacity)
+    double start = now_ns();
+    for (int i = 0; i < procs; i++) {
+        if (Fork() == 0) {
+            // Each claimer counts what it got in its own stats entry
+            orderSlot *o;
+            int k;
+            while ((k = claimParts(shm, sem_shm, NULL, i + 1, capacity, 1, &o)) > 0)
+                atomic_fetch_add_explicit(&shmStats(shm, i + 1)->parts, k, memory_order_relaxed);
+            _exit(0);
+        }
+    }
+    for (int i = 0; i < procs; i++)
+        wait(NULL);
+    double elapsed = now_ns() - start;
+
+    // Claims are counted as if every one took a full batch; with
+    // reservations each claimer's share can end in a short one
+    long claims = (parts + capacity - 1) / capacity, claimed = 0;
+    for (int i = 1; i <= procs; i++)
+        claimed += shmStats(shm, i)->parts;
+    printf("mode=%-6s procs=%4d parts=%9d capacity=%3d claims=%8ld wall_ms=%9.2f ns_per_claim=%8.1f\n",
+           claimModeName(mode), procs, (int)claimed, capacity, claims,
+           elapsed / 1e6, elapsed / claims);
+    fflush(stdout);
+
+    Sem_close(sem_shm);
+    Sem_unlink(SEM_BENCH_NAME);
+    Shmdt(shm);
+    shmctl(shmid, IPC_RMID, NULL);
+}
+
+int main(int argc, char **argv) {
+    // Defaults model a full plant with small capacities
+    int procs = 20, parts = 2000000, capacity = 10;
+
+    if (argc > 1) procs = atoi(argv[1]);
+    if (argc > 2) parts = atoi(argv[2]);
+    if (argc > 3) capacity = atoi(argv[3]);
+
+    if (argc > 4 || procs <= 0 || parts <= 0 || capacity <= 0) {
+        fprintf(stderr, "Usage: %s [procs] [parts] [capacity]\n", argv[0]);
+        return 1;
+    }
+
+    // A stale semaphore from an interrupted run would make O_EXCL fail
+    sem_unlink(SEM_BENCH_NAME);
+
+    run_round(CLAIM_SEM,    procs, parts, capacity);
+    run_round(CLAIM_ATOMIC, procs, parts, capacity);
+    run_round(CLAIM_STEAL,  procs, parts, capacity);
+    return 0;
+}
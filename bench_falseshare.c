@@ -0,0 +1,88 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+// False-sharing microbenchmark for the shared-memory layout.
+// Forks <procs> writers, each pinned to its own core (round-robin over
+// the online CPUs), and has every writer bump only its own counter
+// <iters> times. Run once with the counters packed next to each other
+// the way the old 16-byte shData packed made/remain/activeFactories,
+// and once with each counter on its own cache line as shmem.h now
+// lays them out. The difference is the cost of coherence traffic.
+//----------------------------------------------------------------------
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/wait.h>
+
+#include "wrappers.h"
+#include "shmem.h"
+
+// One writer's counter when padded out to a full cache line
+typedef struct {
+    _Alignas(CACHE_LINE) _Atomic int count;
+} paddedCounter;
+
+// Pin the calling process to one CPU
+static void pin_to(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) < 0)
+        perror("sched_setaffinity");
+}
+
+// Runs one round; 'stride' is the distance in bytes between counters
+static void run_round(const char *layout, size_t stride, int procs, long iters) {
+    int ncpu = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int shmid = Shmget(IPC_PRIVATE, stride * procs + CACHE_LINE, IPC_CREAT | S_IRUSR | S_IWUSR);
+    char *base = (char*)Shmat(shmid, NULL, 0);
+
+    long long start = Clock_ns();
+    for (int p = 0; p < procs; p++) {
+        if (Fork() == 0) {
+            pin_to(p % ncpu);
+            _Atomic int *mine = (_Atomic int*)(base + p * stride);
+            for (long i = 0; i < iters; i++)
+                atomic_fetch_add_explicit(mine, 1, memory_order_relaxed);
+            _exit(0);
+        }
+    }
+    for (int p = 0; p < procs; p++)
+        wait(NULL);
+    long long elapsed = Clock_ns() - start;
+
+    printf("layout=%-6s procs=%4d cpus=%3d iters=%10ld wall_ms=%9.2f ns_per_op=%7.2f\n",
+           layout, procs, ncpu, iters, elapsed / 1e6, (double)elapsed / ((double)iters * procs));
+    fflush(stdout);
+
+    Shmdt(base);
+    shmctl(shmid, IPC_RMID, NULL);
+}
+
+int main(int argc, char **argv) {
+    int procs = 20;
+    long iters = 10000000;
+
+    if (argc > 1) procs = atoi(argv[1]);
+    if (argc > 2) iters = atol(argv[2]);
+
+    if (argc > 3 || procs <= 0 || iters <= 0) {
+        fprintf(stderr, "Usage: %s [procs] [iters_per_proc]\n", argv[0]);
+        return 1;
+    }
+
+    run_round("packed", sizeof(_Atomic int), procs, iters);
+    run_round("padded", sizeof(paddedCounter), procs, iters);
+    return 0;
+}
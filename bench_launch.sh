@@ -0,0 +1,31 @@
+#!/bin/sh
+#---------------------------------------------------------------------
+# Assignment : PA-02 Concurrent Processes & IPC
+# Date       : 10/25/25
+# Author     : Aiden Smith and Braden Drake
+#---------------------------------------------------------------------
+# Startup benchmark: launches N factories with each launch path and
+# prints CSV on stdout. launch_ms is how long Sales spent launching,
+# running_ms how long until the last factory was actually running.
+# Batches take no time, so the order is over as soon as they are up.
+#
+# Usage: ./bench_launch.sh [sales options...]
+#---------------------------------------------------------------------
+
+COUNTS=${COUNTS:-"10 100 500 1000"}
+LAUNCHES=${LAUNCHES:-"fork spawn zygote"}
+
+echo "launch,factories,launch_ms,running_ms,wall_ms"
+for n in $COUNTS; do
+    for launch in $LAUNCHES; do
+        rm -f factory.log
+        start=$(date +%s%N)
+        line=$(./sales --launch "$launch" --time-scale 0 "$@" "$n" "$n" | grep '^SALES: Launched') || exit 1
+        end=$(date +%s%N)
+
+        # "SALES: Launched N factories by L in X ms; all were running after Y ms"
+        launch_ms=$(echo "$line" | sed -n 's/.* in \([0-9.]*\) ms;.*/\1/p')
+        running_ms=$(echo "$line" | sed -n 's/.*after \([0-9.]*\) ms.*/\1/p')
+        echo "$launch,$n,$launch_ms,$running_ms,$(( (end - start) / 1000000 ))"
+    done
+done
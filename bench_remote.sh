@@ -0,0 +1,64 @@
+#!/bin/sh
+#---------------------------------------------------------------------
+# Assignment : PA-02 Concurrent Processes & IPC
+# Date       : 10/25/25
+# Author     : Aiden Smith and Braden Drake
+#---------------------------------------------------------------------
+# Remote factory benchmark over loopback: of FACTORIES factories, R
+# connect to Sales' gateway as remote ones (factory --connect) and the
+# rest are Sales' own. Prints CSV on stdout; every row must end with
+# the whole order made. R = 0 is the all-local baseline.
+#
+# Usage: ./bench_remote.sh [sales options...]
+#---------------------------------------------------------------------
+
+FACTORIES=${FACTORIES:-8}
+ORDER=${ORDER:-20000}
+REMOTES=${REMOTES:-"0 4 7"}
+SOCKETS=${SOCKETS:-"tcp unix"}
+PORT=${PORT:-5525}
+TIME_SCALE=${TIME_SCALE:-0}
+
+run() {     # run <socket> <remote count> <address> [sales options...]
+    sock=$1 r=$2 addr=$3
+    shift 3
+    remote=""
+    [ "$r" -gt 0 ] && remote="--remote $r --listen $addr"
+
+    start=$(date +%s%N)
+    ./sales --time-scale "$TIME_SCALE" --report-delay 0 $remote "$@" $((FACTORIES - r)) "$ORDER" > /dev/null &
+    sales=$!
+    if [ "$r" -gt 0 ]; then
+        sleep 0.2       # let Sales start listening
+        i=0
+        while [ $i -lt "$r" ]; do
+            ./factory --connect "$addr" > /dev/null &
+            i=$((i + 1))
+        done
+    fi
+    wait $sales
+    wait
+    end=$(date +%s%N)
+
+    msgs=$(sed -n 's/^Messages = *\([0-9]*\).*/\1/p' supervisor.log)
+    grand=$(sed -n 's/^Grand total parts made = *\([0-9]*\).*/\1/p' supervisor.log)
+    echo "$sock,$((FACTORIES - r)),$r,$ORDER,$(( (end - start) / 1000000 )),$msgs,$grand"
+}
+
+echo "socket,local,remote,order_size,wall_ms,msgs,grand_total"
+for r in $REMOTES; do
+    # Sales needs at least one factory of its own
+    [ "$r" -ge "$FACTORIES" ] && continue
+    if [ "$r" = 0 ]; then
+        run none 0 "" "$@"
+        continue
+    fi
+    for sock in $SOCKETS; do
+        if [ "$sock" = unix ]; then
+            run unix "$r" "unix:/tmp/bench_remote.$$" "$@"
+        else
+            run tcp "$r" "127.0.0.1:$PORT" "$@"
+            PORT=$((PORT + 1))
+        fi
+    done
+done
@@ -0,0 +1,33 @@
+#!/bin/sh
+#---------------------------------------------------------------------
+# Assignment : PA-02 Concurrent Processes & IPC
+# Date       : 10/25/25
+# Author     : Aiden Smith and Braden Drake
+#---------------------------------------------------------------------
+# Scaling benchmark: runs one order of PARTS_PER_FACTORY * N parts
+# for N = 1 .. 10000 factories in both process and --threads mode
+# and prints CSV on stdout. Wall time includes Sales' 2 second
+# report delay, which is the same for every row.
+#
+# Usage: ./bench_scale.sh [sales options...]
+#---------------------------------------------------------------------
+
+PARTS_PER_FACTORY=${PARTS_PER_FACTORY:-50}
+COUNTS=${COUNTS:-"1 10 100 1000 10000"}
+
+echo "mode,factories,order_size,wall_ms,grand_total"
+for n in $COUNTS; do
+    order=$((n * PARTS_PER_FACTORY))
+    for mode in process threads; do
+        flags="$*"
+        [ "$mode" = threads ] && flags="$flags --threads"
+
+        rm -f factory.log
+        start=$(date +%s%N)
+        ./sales $flags "$n" "$order" > /dev/null || exit 1
+        end=$(date +%s%N)
+
+        grand=$(sed -n 's/^Grand total parts made = *\([0-9]*\).*/\1/p' supervisor.log)
+        echo "$mode,$n,$order,$(( (end - start) / 1000000 )),$grand"
+    done
+done
@@ -0,0 +1,100 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+// A/B benchmark for the factory -> supervisor transports.
+// Forks <producers> processes that each send <msgs> PRODUCTION_MSGs
+// while the parent drains them as the supervisor would, once over the
+// System V message queue and once over the shared-memory ring.
+//----------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/msg.h>
+#include <sys/wait.h>
+
+#include "wrappers.h"
+#include "message.h"
+#include "shmem.h"
+#include "transport.h"
+
+// Monotonic clock in nanoseconds
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Runs one round over the given transport
+static void run_round(int transport, int producers, int msgs) {
+    int shmid = Shmget(IPC_PRIVATE, shmemSize(producers), IPC_CREAT | S_IRUSR | S_IWUSR);
+    shData *shm = (shData*)Shmat(shmid, NULL, 0);
+    int msgid = Msgget(IPC_PRIVATE, IPC_CREAT | S_IRUSR | S_IWUSR);
+
+    shmemInit(shm, producers);
+    shm->transport = transport;
+
+    double start = now_ns();
+    for (int p = 1; p <= producers; p++) {
+        if (Fork() == 0) {
+            msgBuf m;
+            memset(&m, 0, sizeof(m));
+            m.mtype = 1;
+            m.purpose = PRODUCTION_MSG;
+            m.facID = p;
+            for (int i = 0; i < msgs; i++) {
+                m.partsMade = 1;
+                if (sendMsg(shm, msgid, &m) < 0)
+                    unix_error("bench send");
+            }
+            _exit(0);
+        }
+    }
+
+    // Drain everything and check nothing got lost or duplicated
+    long expected = (long)producers * msgs, total = 0;
+    for (long i = 0; i < expected; i++) {
+        msgBuf m;
+        if (recvMsg(shm, msgid, &m) < 0)
+            unix_error("bench recv");
+        total += m.partsMade;
+    }
+    double elapsed = now_ns() - start;
+
+    for (int p = 0; p < producers; p++)
+        wait(NULL);
+
+    printf("transport=%-4s producers=%4d msgs=%9ld received=%9ld wall_ms=%9.2f ns_per_msg=%8.1f\n",
+           transportName(transport), producers, expected, total,
+           elapsed / 1e6, elapsed / expected);
+    fflush(stdout);
+
+    msgctl(msgid, IPC_RMID, NULL);
+    Shmdt(shm);
+    shmctl(shmid, IPC_RMID, NULL);
+}
+
+int main(int argc, char **argv) {
+    int producers = 20, msgs = 10000;
+
+    if (argc > 1) producers = atoi(argv[1]);
+    if (argc > 2) msgs = atoi(argv[2]);
+
+    if (argc > 3 || producers <= 0 || msgs <= 0) {
+        fprintf(stderr, "Usage: %s [producers] [msgs_per_producer]\n", argv[0]);
+        return 1;
+    }
+
+    run_round(TRANSPORT_MSGQ, producers, msgs);
+    run_round(TRANSPORT_RING, producers, msgs);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#!/bin/sh
+#---------------------------------------------------------------------
+# Assignment : PA-02 Concurrent Processes & IPC
+# Date       : 10/25/25
+# Author     : Aiden Smith and Braden Drake
+#---------------------------------------------------------------------
+# Regression baseline: runs Sales on each workload spec (see
+# workload.h) and prints CSV on stdout. Runs are --sim by default, so
+# the same spec and seed give the same makespan every time; set
+# SALES_FLAGS to run on the real clock instead. Throughput is the
+# order size over the makespan.
+#
+# With BASELINE=<csv from an earlier run>, each spec's makespan is
+# checked against its row there, and the script fails if any is more
+# than TOLERANCE percent longer.
+#
+# Usage: ./bench_workload.sh <spec>... [-- sales options...]
+#---------------------------------------------------------------------
+
+SALES_FLAGS=${SALES_FLAGS:-"--sim"}
+TOLERANCE=${TOLERANCE:-5}
+
+specs=""
+while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+    specs="$specs $1"
+    shift
+done
+[ "$1" = "--" ] && shift
+if [ -z "$specs" ]; then
+    echo "Usage: $0 <spec>... [-- sales options...]" >&2
+    exit 1
+fi
+
+status=0
+echo "spec,seed,factories,order_size,makespan_ms,parts_per_s,wall_ms,grand_total"
+for spec in $specs; do
+    start=$(date +%s%N)
+    out=$(./sales $SALES_FLAGS --report-delay 0 --workload "$spec" "$@") || exit 1
+    end=$(date +%s%N)
+
+    seed=$(echo "$out" | sed -n 's/^SALES: Workload seed = \([0-9]*\).*/\1/p')
+    n=$(echo "$out" | grep -c "^SALES: Factory # .* was created")
+    order=$(sed -n 's/^Grand total .* order size of *\([0-9]*\).*/\1/p' supervisor.log)
+    grand=$(sed -n 's/^Grand total parts made = *\([0-9]*\).*/\1/p' supervisor.log)
+    makespan=$(sed -n 's/^Makespan = *\([0-9.]*\) ms.*/\1/p' supervisor.log)
+    rate=$(awk -v o="$order" -v m="$makespan" 'BEGIN { printf "%.1f", (m > 0 ? o * 1000 / m : 0) }')
+    echo "$spec,$seed,$n,$order,$makespan,$rate,$(( (end - start) / 1000000 )),$grand"
+
+    if [ -n "$BASELINE" ]; then
+        base=$(awk -F, -v s="$spec" '$1 == s { print $5 }' "$BASELINE")
+        if [ -n "$base" ] && awk -v m="$makespan" -v b="$base" -v t="$TOLERANCE" \
+                                 'BEGIN { exit !(m > b * (1 + t / 100)) }'; then
+            echo "$spec: makespan $makespan ms vs $base ms in $BASELINE" >&2
+            status=1
+        fi
+    fi
+done
+exit $status
@@ -0,0 +1,180 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "wrappers.h"
+#include "checkpoint.h"
+
+// Each slot starts on its own cache line
+#define CKPT_ALIGN( x )  ( ( (x) + CACHE_LINE - 1 ) & ~(size_t) ( CACHE_LINE - 1 ) )
+
+static size_t slotBytesFor( int nFactories )
+{
+    return CKPT_ALIGN( sizeof( ckptSlot ) + ( nFactories + 1 ) * sizeof( ckptFactory ) ) ;
+}
+
+static ckptSlot *slotAt( checkpoint *c , int i )
+{
+    return (ckptSlot *) ( (char *) c->h + CKPT_ALIGN( sizeof( ckptHeader ) ) + i * c->h->slotBytes ) ;
+}
+
+/*--------------------------------------------------------------------
+   Map 'fd', 'bytes' long, shared so our stores land in the file
+----------------------------------------------------------------------*/
+static checkpoint *mapFile( int fd , size_t bytes )
+{
+    void *p = mmap( NULL , bytes , PROT_READ | PROT_WRITE , MAP_SHARED , fd , 0 ) ;
+    close( fd ) ;
+    if ( p == MAP_FAILED )
+    {
+        perror( "checkpoint mmap" ) ;
+        return NULL ;
+    }
+
+    checkpoint *c = malloc( sizeof( checkpoint ) ) ;
+    if ( c == NULL )
+        unix_error( "checkpoint malloc failed" ) ;
+    c->h = p ;
+    c->bytes = bytes ;
+    c->gen = 0 ;
+    return c ;
+}
+
+/*--------------------------------------------------------------------
+   Sales: start a fresh checkpoint file for 'nFactories' factories,
+   with no slot saved yet
+----------------------------------------------------------------------*/
+checkpoint *ckptCreate( const char *path , int nFactories )
+{
+    size_t bytes = CKPT_ALIGN( sizeof( ckptHeader ) ) + 2 * slotBytesFor( nFactories ) ;
+
+    int fd = open( path , O_RDWR | O_CREAT | O_TRUNC , S_IRUSR | S_IWUSR ) ;
+    if ( fd < 0 || ftruncate( fd , bytes ) < 0 )
+    {
+        perror( path ) ;
+        if ( fd >= 0 )
+            close( fd ) ;
+        return NULL ;
+    }
+
+    checkpoint *c = mapFile( fd , bytes ) ;
+    if ( c == NULL )
+        return NULL ;
+
+    // The file came back zeroed, so both slots read as unwritten
+    c->h->magic = CKPT_MAGIC ;
+    c->h->version = CKPT_VERSION ;
+    c->h->nFactories = nFactories ;
+    c->h->slotBytes = (int) slotBytesFor( nFactories ) ;
+    return c ;
+}
+
+/*--------------------------------------------------------------------
+   Sales --resume: map an existing checkpoint file, to read it and
+   then keep saving into it. Returns NULL if it is not one of ours.
+----------------------------------------------------------------------*/
+checkpoint *ckptOpen( const char *path )
+{
+    int fd = open( path , O_RDWR ) ;
+    struct stat sb ;
+    if ( fd < 0 || fstat( fd , &sb ) < 0 )
+    {
+        perror( path ) ;
+        if ( fd >= 0 )
+            close( fd ) ;
+        return NULL ;
+    }
+    if ( (size_t) sb.st_size < CKPT_ALIGN( sizeof( ckptHeader ) ) )
+    {
+        fprintf( stderr , "%s: not a checkpoint file\n" , path ) ;
+        close( fd ) ;
+        return NULL ;
+    }
+
+    checkpoint *c = mapFile( fd , sb.st_size ) ;
+    if ( c == NULL )
+        return NULL ;
+
+    ckptHeader *h = c->h ;
+    if ( h->magic != CKPT_MAGIC || h->version != CKPT_VERSION || h->nFactories <= 0
+         || (size_t) h->slotBytes != slotBytesFor( h->nFactories )
+         || c->bytes != CKPT_ALIGN( sizeof( ckptHeader ) ) + 2 * (size_t) h->slotBytes )
+    {
+        fprintf( stderr , "%s: checkpoint magic %#x version %u, expected %#x version %u\n" ,
+                 path , h->magic , h->version , CKPT_MAGIC , CKPT_VERSION ) ;
+        ckptClose( c ) ;
+        return NULL ;
+    }
+
+    ckptSlot *s = ckptLatest( c ) ;
+    c->gen = s ? atomic_load( &s->gen ) : 0 ;
+    return c ;
+}
+
+/*--------------------------------------------------------------------
+   The newest completely written slot, or NULL if none was ever saved
+----------------------------------------------------------------------*/
+ckptSlot *ckptLatest( checkpoint *c )
+{
+    ckptSlot *best = NULL ;
+    unsigned  bestGen = 0 ;
+
+    for ( int i = 0 ; i < 2 ; i++ )
+    {
+        unsigned g = atomic_load_explicit( &slotAt( c , i )->gen , memory_order_acquire ) ;
+        if ( g > bestGen )
+        {
+            best = slotAt( c , i ) ;
+            bestGen = g ;
+        }
+    }
+    return best ;
+}
+
+/*--------------------------------------------------------------------
+   Sales: save what the factories have produced so far into the older
+   slot. Only parts whose batch finished count; parts claimed but not
+   yet made would be lost with their factory and are made again.
+----------------------------------------------------------------------*/
+void ckptSave( checkpoint *c , shData *shm , int orderID , int orderSize )
+{
+    ckptSlot *s = slotAt( c , ( c->gen + 1 ) & 1 ) ;
+
+    // Unstamped while it is half written
+    atomic_store( &s->gen , 0 ) ;
+
+    s->orderID = orderID ;
+    s->orderSize = orderSize ;
+    s->made = 0 ;
+    memset( &s->fac[ 0 ] , 0 , sizeof( ckptFactory ) ) ;
+    for ( int i = 1 ; i <= c->h->nFactories ; i++ )
+    {
+        factoryStats *st = shmStats( shm , i ) ;
+        s->fac[ i ].parts  = atomic_load_explicit( &st->parts , memory_order_relaxed ) ;
+        s->fac[ i ].iters  = atomic_load_explicit( &st->iters , memory_order_relaxed ) ;
+        s->fac[ i ].busyMs = atomic_load_explicit( &st->busyMs , memory_order_relaxed ) ;
+        s->made += s->fac[ i ].parts ;
+    }
+
+    // The stamp goes last
+    atomic_store_explicit( &s->gen , ++c->gen , memory_order_release ) ;
+}
+
+//------------------
+
+void ckptClose( checkpoint *c )
+{
+    munmap( c->h , c->bytes ) ;
+    free( c ) ;
+}
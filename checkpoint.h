@@ -0,0 +1,59 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdatomic.h>
+
+#include "shmem.h"
+
+// Progress on a single order, kept in a memory-mapped file so it
+// outlives Sales. The file holds two slots written alternately: a
+// save only ever overwrites the older one and stamps it last, so
+// whichever moment Sales dies at, the newer complete slot is intact.
+// Nothing is msync'ed; the page cache already survives the process
+#define CKPT_MAGIC      0x54323543      // "T25C"
+#define CKPT_VERSION    1
+
+// One factory's totals when the slot was saved
+typedef struct
+{
+    int       parts ;
+    int       iters ;
+    long long busyMs ;
+} ckptFactory ;
+
+typedef struct
+{
+    _Atomic unsigned gen ;      // 0 while being written, then one more than the other slot's
+    int         orderID ;
+    int         orderSize ;
+    int         made ;          // parts actually produced, the sum of fac[].parts
+    ckptFactory fac[] ;         // nFactories + 1, entry 0 unused
+} ckptSlot ;
+
+typedef struct
+{
+    unsigned  magic ;           // CKPT_MAGIC
+    unsigned  version ;         // CKPT_VERSION
+    int       nFactories ;
+    int       slotBytes ;       // each of the two slots that follow
+} ckptHeader ;
+
+typedef struct
+{
+    ckptHeader *h ;
+    size_t      bytes ;
+    unsigned    gen ;           // generation of the newest slot
+} checkpoint ;
+
+checkpoint *ckptCreate( const char *path , int nFactories ) ;
+checkpoint *ckptOpen( const char *path ) ;
+ckptSlot   *ckptLatest( checkpoint *c ) ;
+void        ckptSave( checkpoint *c , shData *shm , int orderID , int orderSize ) ;
+void        ckptClose( checkpoint *c ) ;
+
+#endif
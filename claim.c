@@ -0,0 +1,353 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "wrappers.h"
+#include "claim.h"
+
+/*--------------------------------------------------------------------
+   Does the order policy put order 'o' before order 'best'?
+----------------------------------------------------------------------*/
+static int comesFirst( shData *shm , orderSlot *o , orderSlot *best )
+{
+    if ( shm->orderPolicy == ORDER_EDF && o->deadline != best->deadline )
+        return o->deadline < best->deadline ;
+    return o->orderID < best->orderID ;
+}
+
+/*--------------------------------------------------------------------
+   The open order a factory should work on next under the order
+   policy, or NULL if no order has parts left to claim
+----------------------------------------------------------------------*/
+static orderSlot *pickOrder( shData *shm )
+{
+    orderSlot *best = NULL ;
+
+    for ( int i = 0 ; i < MAXORDERS ; i++ )
+    {
+        orderSlot *o = &shm->orders[i] ;
+        if ( atomic_load_explicit( &o->state , memory_order_acquire ) != SLOT_OPEN
+             || atomic_load_explicit( &o->remain , memory_order_relaxed ) <= 0 )
+            continue ;
+
+        if ( best == NULL || comesFirst( shm , o , best ) )
+            best = o ;
+    }
+    return best ;
+}
+
+/*--------------------------------------------------------------------
+   CLAIM_STEAL: every open order, in the order the policy would pick
+   them. Returns how many there are.
+----------------------------------------------------------------------*/
+static int openOrders( shData *shm , orderSlot **out )
+{
+    int n = 0 ;
+
+    for ( int i = 0 ; i < MAXORDERS ; i++ )
+    {
+        orderSlot *o = &shm->orders[i] ;
+        if ( atomic_load_explicit( &o->state , memory_order_acquire ) != SLOT_OPEN )
+            continue ;
+
+        int j = n++ ;
+        for ( ; j > 0 && comesFirst( shm , o , out[j - 1] ) ; j-- )
+            out[j] = out[j - 1] ;
+        out[j] = o ;
+    }
+    return n ;
+}
+
+/*--------------------------------------------------------------------
+   CLAIM_STEAL: take up to 'most' parts from one reservation entry,
+   which thieves may be shrinking at the same time
+----------------------------------------------------------------------*/
+static int takeParts( _Atomic int *left , int most , long *retries )
+{
+    int v = atomic_load_explicit( left , memory_order_relaxed ) ;
+    while ( v > 0 )
+    {
+        int k = ( v < most ) ? v : most ;
+        if ( atomic_compare_exchange_weak_explicit( left , &v , v - k ,
+                                memory_order_acq_rel , memory_order_relaxed ) )
+            return k ;
+        ( *retries )++ ;
+    }
+    return 0 ;
+}
+
+/*--------------------------------------------------------------------
+   CLAIM_STEAL: our own entries for every order are empty. Find the
+   factory with the most parts of slot 'i' left, take half of them,
+   keep a batch and put the rest in our own entry. Returns the batch,
+   or 0 once nobody has any of this order left.
+----------------------------------------------------------------------*/
+static int stealParts( shData *shm , int facID , int i , int capacity , long *retries )
+{
+    for ( ;; )
+    {
+        int victim = 0 , most = 0 ;
+        for ( int f = 1 ; f <= shm->nFactories ; f++ )
+        {
+            int v = atomic_load_explicit( &shmResv( shm , f )->left[i] , memory_order_relaxed ) ;
+            if ( f != facID && v > most )
+            {
+                victim = f ;
+                most = v ;
+            }
+        }
+        if ( victim == 0 )
+            return 0 ;
+
+        int got = takeParts( &shmResv( shm , victim )->left[i] , ( most + 1 ) / 2 , retries ) ;
+        if ( got == 0 )
+            continue ;      // somebody emptied it first: look again
+
+        int batch = ( got < capacity ) ? got : capacity ;
+        if ( got > batch )
+            atomic_fetch_add_explicit( &shmResv( shm , facID )->left[i] , got - batch , memory_order_relaxed ) ;
+        return batch ;
+    }
+}
+
+/*--------------------------------------------------------------------
+   How many of the 'remain' parts left in an order a factory with the
+   given capacity and duration should take, under the batch policy.
+   Never more than capacity, never less than one part.
+----------------------------------------------------------------------*/
+static int batchSize( shData *shm , int remain , int capacity , int duration )
+{
+    long want = capacity ;
+
+    switch ( shm->batchPolicy )
+    {
+    case BATCH_GUIDED:
+    {
+        // Each claim takes its 1/N share of what is left, so batches
+        // shrink and everybody finishes their last one close together
+        int n = shmJoined( shm ) ;
+        want = ( remain + n - 1 ) / n ;
+        break ;
+    }
+
+    case BATCH_RATE:
+        // Take the share of what is left that matches our share of the
+        // plant's total rate, so a slow factory never sits on the tail
+        if ( shm->totalRate > 0 && duration > 0 )
+            want = (long) ( remain * ( (double) capacity / duration ) / shm->totalRate + 0.999 ) ;
+        break ;
+    }
+
+    if ( want > capacity ) want = capacity ;
+    if ( want > remain )   want = remain ;
+    if ( want < 1 )        want = 1 ;
+    return (int) want ;
+}
+
+/*--------------------------------------------------------------------
+   Claim a batch of at most 'capacity' parts from one of the open orders.
+   Returns the number of parts claimed and stores the order they
+   belong to in *order; returns 0 once no open order has parts left.
+   The slot cannot be reused until all of its parts are delivered,
+   so *order stays valid while the caller still owes it parts.
+----------------------------------------------------------------------*/
+int claimParts( shData *shm , sem_t *sem_shm , procInstr *in , int facID ,
+                int capacity , int duration , orderSlot **order )
+{
+    int to_make = 0 ;
+    orderSlot *o ;
+
+    // Reservations: our own entries first, in policy order, and only
+    // then somebody else's. Batches are simply up to capacity here;
+    // the other batch policies size them from the shared 'remain'
+    if ( shm->claimMode == CLAIM_STEAL )
+    {
+        orderSlot *open[ MAXORDERS ] ;
+        int n = openOrders( shm , open ) ;
+        long retries = 0 ;
+        int stolen = 0 ;
+
+        for ( int k = 0 ; k < n && to_make == 0 ; k++ )
+        {
+            to_make = takeParts( &shmResv( shm , facID )->left[ open[k] - shm->orders ] , capacity , &retries ) ;
+            *order = open[k] ;
+        }
+        for ( int k = 0 ; k < n && to_make == 0 ; k++ )
+        {
+            to_make = stolen = stealParts( shm , facID , open[k] - shm->orders , capacity , &retries ) ;
+            *order = open[k] ;
+        }
+
+        if ( in != NULL )
+        {
+            instrCount( &in->casRetries , retries ) ;
+            instrCount( &in->steals , stolen > 0 ) ;
+        }
+        return to_make ;
+    }
+
+    // Fallback: mutual exclusion through the named semaphore
+    if ( shm->claimMode == CLAIM_SEM )
+    {
+        long long t0 = Clock_ns() ;
+        int blocked = Sem_waitCounted( sem_shm ) ;
+        long long t1 = Clock_ns() ;
+        if ( blocked )
+            atomic_fetch_add_explicit( &shm->semWaits , 1 , memory_order_relaxed ) ;
+        if ( ( o = pickOrder( shm ) ) != NULL )
+        {
+            int remain = atomic_load_explicit( &o->remain , memory_order_relaxed ) ;
+            to_make = batchSize( shm , remain , capacity , duration ) ;
+            atomic_store_explicit( &o->remain , remain - to_make , memory_order_relaxed ) ;
+            atomic_fetch_add_explicit( &o->made , to_make , memory_order_relaxed ) ;
+            *order = o ;
+        }
+        Sem_post( sem_shm ) ;
+
+        if ( in != NULL )
+        {
+            histRecord( &in->shmWait , t1 - t0 ) ;
+            histRecord( &in->shmHold , Clock_ns() - t1 ) ;
+            instrCount( &in->shmBlocked , blocked ) ;
+        }
+        return to_make ;
+    }
+
+    // Lock-free: retry the CAS until we win it or the order runs dry,
+    // in which case go look for another one. A failed CAS reloads
+    // 'remain' for us.
+    long retries = 0 ;
+    int  claimed = 0 ;
+    while ( !claimed && ( o = pickOrder( shm ) ) != NULL )
+    {
+        int remain = atomic_load_explicit( &o->remain , memory_order_relaxed ) ;
+        while ( remain > 0 )
+        {
+            to_make = batchSize( shm , remain , capacity , duration ) ;
+            if ( atomic_compare_exchange_weak_explicit( &o->remain , &remain , remain - to_make ,
+                                    memory_order_acq_rel , memory_order_relaxed ) )
+            {
+                atomic_fetch_add_explicit( &o->made , to_make , memory_order_relaxed ) ;
+                *order = o ;
+                claimed = 1 ;
+                break ;
+            }
+            retries++ ;
+        }
+    }
+
+    if ( in != NULL )
+        instrCount( &in->casRetries , retries ) ;
+    return claimed ? to_make : 0 ;
+}
+
+/*--------------------------------------------------------------------
+   Parts of order 'o' nobody has claimed yet. With reservations that
+   is what is left in every factory's entry; 'remain' is not kept.
+----------------------------------------------------------------------*/
+int orderUnclaimed( shData *shm , orderSlot *o )
+{
+    if ( shm->claimMode != CLAIM_STEAL )
+        return atomic_load_explicit( &o->remain , memory_order_relaxed ) ;
+
+    int left = 0 ;
+    for ( int f = 1 ; f <= shm->nFactories ; f++ )
+        left += atomic_load_explicit( &shmResv( shm , f )->left[ o - shm->orders ] , memory_order_relaxed ) ;
+    return left ;
+}
+
+/*--------------------------------------------------------------------
+   Factory 'facID' claimed 'parts' of order 'o' but will never make
+   them: put them back where the next claim looks, so orderUnclaimed
+   counts them again
+----------------------------------------------------------------------*/
+void returnParts( shData *shm , sem_t *sem_shm , int facID , orderSlot *o , int parts )
+{
+    atomic_fetch_sub_explicit( &o->made , parts , memory_order_relaxed ) ;
+
+    // With reservations, into our own entry; the others steal them
+    if ( shm->claimMode == CLAIM_STEAL )
+    {
+        atomic_fetch_add_explicit( &shmResv( shm , facID )->left[ o - shm->orders ] , parts ,
+                                   memory_order_relaxed ) ;
+        return ;
+    }
+
+    // CLAIM_SEM updates 'remain' with a plain load and store, so only
+    // under sem_shm is an add safe from being overwritten
+    if ( shm->claimMode == CLAIM_SEM )
+        Sem_wait( sem_shm ) ;
+    atomic_fetch_add_explicit( &o->remain , parts , memory_order_relaxed ) ;
+    if ( shm->claimMode == CLAIM_SEM )
+        Sem_post( sem_shm ) ;
+}
+
+/*--------------------------------------------------------------------
+   Convert claim modes to / from their command-line names
+----------------------------------------------------------------------*/
+const char *claimModeName( int mode )
+{
+    switch ( mode )
+    {
+    case CLAIM_SEM:   return "sem" ;
+    case CLAIM_STEAL: return "steal" ;
+    default:          return "atomic" ;
+    }
+}
+
+int claimModeFromName( const char *name )
+{
+    if ( strcmp( name , "atomic" ) == 0 )
+        return CLAIM_ATOMIC ;
+    if ( strcmp( name , "sem" ) == 0 )
+        return CLAIM_SEM ;
+    if ( strcmp( name , "steal" ) == 0 )
+        return CLAIM_STEAL ;
+    return -1 ;
+}
+
+/*--------------------------------------------------------------------
+   Convert order policies to / from their command-line names
+----------------------------------------------------------------------*/
+const char *orderPolicyName( int policy )
+{
+    return ( policy == ORDER_EDF ) ? "edf" : "fifo" ;
+}
+
+int orderPolicyFromName( const char *name )
+{
+    if ( strcmp( name , "fifo" ) == 0 )
+        return ORDER_FIFO ;
+    if ( strcmp( name , "edf" ) == 0 )
+        return ORDER_EDF ;
+    return -1 ;
+}
+
+/*--------------------------------------------------------------------
+   Convert batch policies to / from their command-line names
+----------------------------------------------------------------------*/
+const char *batchPolicyName( int policy )
+{
+    switch ( policy )
+    {
+    case BATCH_GUIDED: return "guided" ;
+    case BATCH_RATE:   return "rate" ;
+    default:           return "fixed" ;
+    }
+}
+
+int batchPolicyFromName( const char *name )
+{
+    if ( strcmp( name , "fixed" ) == 0 )
+        return BATCH_FIXED ;
+    if ( strcmp( name , "guided" ) == 0 )
+        return BATCH_GUIDED ;
+    if ( strcmp( name , "rate" ) == 0 )
+        return BATCH_RATE ;
+    return -1 ;
+}
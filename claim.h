@@ -0,0 +1,24 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef CLAIM_H
+#define CLAIM_H
+
+#include <semaphore.h>
+
+#include "shmem.h"
+
+int claimParts( shData *shm , sem_t *sem_shm , procInstr *in , int facID ,
+                int capacity , int duration , orderSlot **order ) ;
+int orderUnclaimed( shData *shm , orderSlot *o ) ;
+void returnParts( shData *shm , sem_t *sem_shm , int facID , orderSlot *o , int parts ) ;
+const char *claimModeName( int mode ) ;
+int claimModeFromName( const char *name ) ;
+const char *orderPolicyName( int policy ) ;
+int orderPolicyFromName( const char *name ) ;
+const char *batchPolicyName( int policy ) ;
+int batchPolicyFromName( const char *name ) ;
+
+#endif
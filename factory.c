@@ -19,30 +19,110 @@
 #include <semaphore.h>
 #include <fcntl.h>
 #include <time.h>
+#include <stdint.h>
+#include <sys/wait.h>
 
 #include "wrappers.h"
 #include "message.h"
 #include "shmem.h"
+#include "factory.h"
+#include "logger.h"
+
+// Run factory 'id' in this process, logging to stdout (factory.log)
+static void run_one(int id, int capacity, int duration, shData *shm, int msgid,
+                    sem_t *sem_shm, sem_t *sem_log) {
+    factoryArgs a = {
+        .id = id, .capacity = capacity, .duration = duration,
+        .shm = shm, .msgid = msgid,
+        .sem_shm = sem_shm, .sem_log = sem_log,
+        .log = stdout, .lg = NULL
+    };
+    if (shm->logMode == LOG_ASYNC || shm->logMode == LOG_ASYNC_TAGGED)
+        a.lg = logOpen(stdout, shm->logMode, &shm->logSeq, shm->startNs);
+    runFactory(&a);
+    if (a.lg)
+        logClose(a.lg);
+}
+
+// Zygote: with shared memory, the queue and both semaphores already
+// set up, fork one factory per zygoteReq Sales writes to our stdin.
+// Children skip exec and all of that setup. Once Sales closes the
+// pipe, hand the supervisor the pids to watch and reap the children,
+// marking each as exited before its pid can be reused
+static void zygote(shData *shm, int msgid, sem_t *sem_shm, sem_t *sem_log) {
+    zygoteReq r;
+
+    fflush(stdout);
+    while (read(STDIN_FILENO, &r, sizeof(r)) == sizeof(r)) {
+        pid_t pid = Fork();
+        if (pid == 0) {
+            run_one(r.id, r.capacity, r.duration, shm, msgid, sem_shm, sem_log);
+            fflush(stdout);
+            _exit(0);
+        }
+        shmStats(shm, r.id)->pid = pid;
+    }
+
+    uint64_t one = 1;
+    atomic_fetch_add(&shm->pidsPosted, 1);
+    if (write(shm->doorbellFd, &one, sizeof(one)) < 0)
+        perror("zygote doorbell");
+
+    siginfo_t si;
+    while (waitid(P_ALL, 0, &si, WEXITED | WNOWAIT) == 0) {
+        for (int i = 1; i <= shm->nFactories; i++)
+            if (shmStats(shm, i)->pid == si.si_pid) {
+                atomic_store(&shmStats(shm, i)->exited, 1);
+                break;
+            }
+        waitpid(si.si_pid, NULL, 0);
+    }
+}
 
 int main(int argc, char **argv) {
+    // Zygote mode takes no factory of its own
+    bool is_zygote = (argc == 6 && strcmp(argv[1], "--zygote") == 0);
+
+    // A remote factory only has Sales' gateway address, and draws
+    // its own capacity and duration unless given them
+    if (argc >= 3 && strcmp(argv[1], "--connect") == 0) {
+        srand((unsigned)time(NULL) ^ (unsigned)getpid());
+        int capacity = (int)(rand()%41) + 10;
+        int duration = (int)(rand()%701) + 500;
+        if (argc == 5) {
+            capacity = atoi(argv[3]);
+            duration = atoi(argv[4]);
+        }
+        if ((argc != 3 && argc != 5) || capacity <= 0 || duration < 0) {
+            fprintf(stderr, "Usage: %s --connect <unix:PATH|HOST:PORT> [capacity duration_ms]\n", argv[0]);
+            return 1;
+        }
+        return runRemoteFactory(argv[2], capacity, duration);
+    }
+
     // Wrong number of arguments
-    if (argc != 8) {
-        fprintf(stderr, "Usage: %s <id> <capacity> <duration_ms> <shm_key> <msg_key> <SEM_SHM> <SEM_LOG>\n", argv[0]);
+    if (argc != 8 && !is_zygote) {
+        fprintf(stderr, "Usage: %s <id> <capacity> <duration_ms> <shm_key> <msg_key> <SEM_SHM> <SEM_LOG>\n"
+                        "       %s --zygote <shm_key> <msg_key> <SEM_SHM> <SEM_LOG>\n"
+                        "       %s --connect <unix:PATH|HOST:PORT> [capacity duration_ms]\n",
+                argv[0], argv[0], argv[0]);
         return 1;
     }
 
     // Get id, capacity, duration, keys, and sem names
-    int id = atoi(argv[1]);
-    int capacity = atoi(argv[2]);
-    int duration = atoi(argv[3]);
-    key_t shmkey = (key_t)atoi(argv[4]);
-    key_t msgkey = (key_t)atoi(argv[5]);
-    const char *SEM_SHM_NAME = argv[6];
-    const char *SEM_LOG_NAME = argv[7];
+    char **rest = is_zygote ? argv + 2 : argv + 4;
+    int id = is_zygote ? 0 : atoi(argv[1]);
+    int capacity = is_zygote ? 0 : atoi(argv[2]);
+    int duration = is_zygote ? 0 : atoi(argv[3]);
+    key_t shmkey = (key_t)atoi(rest[0]);
+    key_t msgkey = (key_t)atoi(rest[1]);
+    const char *SEM_SHM_NAME = rest[2];
+    const char *SEM_LOG_NAME = rest[3];
 
     // Get and attach to shared memory
-    int shmid = Shmget(shmkey, SHMEM_SIZE, S_IRUSR | S_IWUSR);
+    int shmid = Shmget(shmkey, 0, S_IRUSR | S_IWUSR);
     shData *shm  = (shData*)Shmat(shmid, NULL, 0);
+    shmemCheck(shm);
 
     // Get message queue
     int msgid = Msgget(msgkey, S_IRUSR | S_IWUSR);
@@ -51,75 +131,10 @@ int main(int argc, char **argv) {
     sem_t *sem_shm = Sem_open2(SEM_SHM_NAME, 0);
     sem_t *sem_log = Sem_open2(SEM_LOG_NAME, 0);
 
-    // Start factory
-    Sem_wait(sem_log);
-    printf("Factory # %2d: STARTED. My Capacity = %3d, in %4d milliSeconds\n", id, capacity, duration);
-    fflush(stdout);
-    Sem_post(sem_log);
-
-    // Iterations and total
-    int iterations = 0;
-    int total_made_by_me = 0;
-
-    // Make parts, print stdout and send production
-    // message to supervisor via message queue
-    for (;;) {
-        int to_make = 0;
-
-        // Mutual exclusion
-        Sem_wait(sem_shm);
-        if (shm->remain > 0) {
-            to_make = (shm->remain >= capacity) ? capacity : shm->remain;
-            shm->remain -= to_make;
-            shm->made += to_make;
-        }
-        Sem_post(sem_shm);
-
-        // Done
-        if (to_make == 0)
-            break;
-
-        // Log to the shared factory.log
-        Sem_wait(sem_log);
-        printf("Factory # %2d: Going to make   %3d parts in %4d milliSecs\n", id, to_make, duration);
-        fflush(stdout);
-        Sem_post(sem_log);
-
-        // Sleep for duration
-        Usleep((useconds_t)duration * 1000);
-
-        // Message to supervisor
-        msgBuf m;
-        m.mtype = 1;
-        m.purpose = PRODUCTION_MSG;
-        m.facID = id;
-        m.capacity = capacity;
-        m.partsMade = to_make;
-        m.duration = duration;
-        if (msgsnd(msgid, &m, MSG_INFO_SIZE, 0) < 0) {
-            perror("factory msgsnd(PRODUCTION)");
-        }
-
-        // Increment iterations and add to total
-        iterations++;
-        total_made_by_me += to_make;
-    }
-
-    // Completion, send one final message to supervisor
-    msgBuf done;
-    memset(&done, 0, sizeof(done));
-    done.mtype = 1;
-    done.purpose = COMPLETION_MSG;
-    done.facID = id;
-    if (msgsnd(msgid, &done, MSG_INFO_SIZE, 0) < 0) {
-        perror("factory msgsnd(COMPLETION)");
-    }
-
-    // Done
-    Sem_wait(sem_log);
-    printf(">>> Factory #  %2d: Terminating after making total of %4d parts in %3d iterations\n", id, total_made_by_me, iterations);
-    fflush(stdout);
-    Sem_post(sem_log);
+    if (is_zygote)
+        zygote(shm, msgid, sem_shm, sem_log);
+    else
+        run_one(id, capacity, duration, shm, msgid, sem_shm, sem_log);
 
     // Close semaphores
     Sem_close(sem_shm);
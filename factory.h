@@ -0,0 +1,41 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef FACTORY_H
+#define FACTORY_H
+
+#include <stdio.h>
+#include <semaphore.h>
+
+#include "shmem.h"
+#include "logger.h"
+#include "trace.h"
+
+// Everything one factory needs, whether it runs as its own
+// process (factory.c) or as a thread inside Sales (--threads)
+typedef struct
+{
+    int     id , capacity , duration ;
+    shData *shm ;
+    int     msgid ;
+    sem_t  *sem_shm , *sem_log ;
+    FILE   *log ;           // factory.log
+    logger *lg ;            // async logger on 'log', NULL in LOG_SYNC mode
+    traceWriter *tw ;       // factory.trace, opened by runFactory in LOG_BINARY mode
+    procInstr *in ;         // our instrumentation entry, set by runFactory
+    long long simNs ;       // --sim: our virtual clock, as startNs + virtual time
+} factoryArgs ;
+
+// One launch request Sales writes down the zygote's stdin
+typedef struct
+{
+    int     id , capacity , duration ;
+} zygoteReq ;
+
+int   runFactory( factoryArgs *a ) ;
+int   runRemoteFactory( const char *addr , int capacity , int duration ) ;
+void *factoryThread( void *arg ) ;
+
+#endif
@@ -0,0 +1,350 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "wrappers.h"
+#include "message.h"
+#include "shmem.h"
+#include "claim.h"
+#include "transport.h"
+#include "simclock.h"
+#include "placement.h"
+#include "net.h"
+#include "factory.h"
+
+// When something happens to us: now, or in simulated time our virtual
+// clock, so traces and tagged logs line up with the batch durations
+static long long factoryNow(factoryArgs *a) {
+    return a->shm->simulated ? a->simNs : Clock_ns();
+}
+
+// Write one line to factory.log: through the async logger if there is
+// one, otherwise the classic way under sem_log
+static void factoryLog(factoryArgs *a, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    if (a->lg) {
+        logVprintfAt(a->lg, factoryNow(a), fmt, ap);
+    } else {
+        long long t0 = Clock_ns();
+        int blocked = Sem_waitCounted(a->sem_log);
+        long long t1 = Clock_ns();
+        if (blocked)
+            atomic_fetch_add_explicit(&a->shm->semWaits, 1, memory_order_relaxed);
+        vfprintf(a->log, fmt, ap);
+        fflush(a->log);
+        Sem_post(a->sem_log);
+
+        histRecord(&a->in->logWait, t1 - t0);
+        histRecord(&a->in->logHold, Clock_ns() - t1);
+        instrCount(&a->in->logBlocked, blocked);
+    }
+    va_end(ap);
+}
+
+// Record one factory event: a binary trace record in LOG_BINARY mode,
+// otherwise the matching factory.log line
+static void factoryEvent(factoryArgs *a, int event, int orderID, int x, int y) {
+    if (a->tw) {
+        traceEventAt(a->tw, factoryNow(a), event, a->id, orderID, x, y);
+        return;
+    }
+    switch (event) {
+    case EV_FACTORY_STARTED: factoryLog(a, FMT_FACTORY_STARTED, a->id, x, y); break;
+    case EV_FACTORY_BATCH:   factoryLog(a, FMT_FACTORY_BATCH,   a->id, x, y); break;
+    case EV_FACTORY_DONE:    factoryLog(a, FMT_FACTORY_DONE,    a->id, x, y); break;
+    }
+}
+
+// Reports waiting to be coalesced into one send
+typedef struct {
+    msgBatch  batch;
+    long long firstNs;      // when the oldest pending record was queued
+} reportQueue;
+
+// Send whatever is pending, as a plain msgBuf if there is only one
+static void flushReports(factoryArgs *a, reportQueue *q) {
+    msgBatch *b = &q->batch;
+    if (b->count == 0)
+        return;
+
+    long long t0 = Clock_ns();
+    int rc = (b->count == 1) ? sendMsg(a->shm, a->msgid, &b->recs[0])
+                             : sendBatch(a->shm, a->msgid, b);
+    histRecord(&a->in->send, Clock_ns() - t0);
+    if (rc < 0) {
+        perror("factory msgsnd");
+    }
+    b->count = 0;
+}
+
+// Queue one message for the supervisor, sending once Sales' coalesce
+// count is reached or the oldest pending record is flushMs old. With
+// the default count of 1 every message goes out immediately
+static void queueReport(factoryArgs *a, reportQueue *q, msgBuf *m) {
+    shData *shm = a->shm;
+    msgBatch *b = &q->batch;
+
+    m->queuedNs = Clock_ns();
+    m->simNs = a->simNs;
+    if (b->count == 0)
+        q->firstNs = m->queuedNs;
+    m->mtype = MSG_TYPE_SINGLE;
+    b->recs[b->count++] = *m;
+
+    if (b->count >= shm->msgCoalesce
+        || (shm->flushMs > 0 && Clock_ns() - q->firstNs >= shm->flushMs * 1000000LL))
+        flushReports(a, q);
+}
+
+// Sleep 'us' microseconds, waking up to send what is pending once the
+// oldest record is flushMs old, so no report waits out a whole batch
+static void sleepFlushing(factoryArgs *a, reportQueue *q, long long us) {
+    shData *shm = a->shm;
+
+    while (us > 0) {
+        long long nap = us;
+        if (q->batch.count > 0 && shm->flushMs > 0) {
+            long long left = (q->firstNs + shm->flushMs * 1000000LL - Clock_ns()) / 1000;
+            if (left <= 0) {
+                flushReports(a, q);
+                continue;
+            }
+            if (left < nap)
+                nap = left;
+        }
+        Usleep((useconds_t)nap);
+        us -= nap;
+    }
+}
+
+// Runs one factory until the order is exhausted
+int runFactory(factoryArgs *a) {
+    shData *shm = a->shm;
+    int id = a->id, capacity = a->capacity, duration = a->duration;
+
+    // Start factory, on its own CPU if Sales asked for pinning
+    int cpu = placementFactoryCpu(shm, id);
+    if (cpu >= 0 && pinSelf(cpu) == 0)
+        shmStats(shm, id)->cpu = cpu;
+    atomic_store(&shmStats(shm, id)->startedNs, Clock_ns());
+    a->in = shmInstr(shm, id);
+    a->simNs = shm->startNs;
+    a->tw = (shm->logMode == LOG_BINARY) ? traceOpen(FACTORY_TRACE) : NULL;
+    factoryEvent(a, EV_FACTORY_STARTED, 0, capacity, duration);
+
+    reportQueue reports;
+    reports.batch.count = 0;
+
+    // With stats in shared memory, tell the supervisor we are up;
+    // production itself is only recorded in our factoryStats entry
+    factoryStats *st = shmStats(shm, id);
+    if (shm->statsInShm) {
+        msgBuf up;
+        memset(&up, 0, sizeof(up));
+        up.purpose = STARTED_MSG;
+        up.facID = id;
+        up.capacity = capacity;
+        up.duration = duration;
+        queueReport(a, &reports, &up);
+    }
+
+    // Iterations and total
+    int iterations = 0;
+    int total_made_by_me = 0;
+
+    // Make parts, print stdout and send production
+    // message to supervisor via message queue
+    for (;;) {
+        // In stream mode, remember which order generation we are on
+        // before claiming, so an order posted while we were busy is
+        // never slept through
+        int w = atomic_load(&shm->workWord);
+
+        for (;;) {
+            // Sales --autoscale can do without us: leave before
+            // claiming anything more
+            if (atomic_load_explicit(&st->retire, memory_order_relaxed))
+                break;
+
+            // In simulated time, wait until ours is the earliest clock
+            if (shm->simulated)
+                simWaitTurn(shm, id);
+
+            // Claim the next batch from whichever open order the
+            // order policy picks (lock-free, under sem_shm, or from
+            // our reservation)
+            orderSlot *o = NULL;
+            int to_make = claimParts(shm, a->sem_shm, a->in, id, capacity, duration, &o);
+
+            // Nothing left in any open order
+            if (to_make == 0) {
+                if (shm->simulated)
+                    simRetire(shm, id);
+                break;
+            }
+
+            // Log to the shared factory.log
+            factoryEvent(a, EV_FACTORY_BATCH, o->orderID, to_make, duration);
+
+            // Sleep for duration (scaled down for benchmarks), or just
+            // move our virtual clock past it; the batch then ends at
+            // startNs + that time
+            long long endNs, busyMs = duration;
+            if (shm->simulated) {
+                endNs = a->simNs = shm->startNs + simAdvance(shm, id, duration) * 1000000LL;
+            } else {
+                busyMs = (long long)(duration * shm->timeScale);
+                if (shm->timeScale > 0)
+                    sleepFlushing(a, &reports, (long long)(duration * 1000 * shm->timeScale));
+                endNs = Clock_ns();
+            }
+
+            // Our own stats entry, nobody else writes it
+            atomic_fetch_add_explicit(&st->parts, to_make, memory_order_relaxed);
+            atomic_fetch_add_explicit(&st->iters, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&st->busyMs, busyMs, memory_order_relaxed);
+            atomic_store_explicit(&st->lastNs, endNs, memory_order_relaxed);
+
+            if (shm->statsInShm) {
+                // No supervisor is counting, so whoever delivers the
+                // last parts of an order completes it
+                if (atomic_fetch_add(&o->delivered, to_make) + to_make == o->order_size)
+                    completeOrder(shm, o);
+            } else {
+                // Message to supervisor
+                msgBuf m;
+                m.purpose = PRODUCTION_MSG;
+                m.facID = id;
+                m.orderID = o->orderID;
+                m.capacity = capacity;
+                m.partsMade = to_make;
+                m.duration = duration;
+                queueReport(a, &reports, &m);
+            }
+
+            // Increment iterations and add to total
+            iterations++;
+            total_made_by_me += to_make;
+        }
+
+        // A single order is over once it runs dry; a stream is over
+        // once Sales says no more orders are coming
+        if (!shm->streaming || atomic_load(&shm->shutdown) || atomic_load(&st->retire))
+            break;
+
+        // Park until Sales opens another order, but not while
+        // holding reports the supervisor needs to finish this one
+        flushReports(a, &reports);
+        Futex_wait((int*)&shm->workWord, w);
+    }
+
+    // Completion, send one final message to supervisor
+    msgBuf done;
+    memset(&done, 0, sizeof(done));
+    done.purpose = COMPLETION_MSG;
+    done.facID = id;
+    queueReport(a, &reports, &done);
+    flushReports(a, &reports);
+
+    // Done
+    factoryEvent(a, EV_FACTORY_DONE, 0, total_made_by_me, iterations);
+    if (a->tw)
+        traceClose(a->tw);
+
+    return 0;
+}
+
+// Thread entry point used by Sales in --threads mode
+void *factoryThread(void *arg) {
+    runFactory((factoryArgs*)arg);
+    return NULL;
+}
+
+// Runs a factory on another host: every claim is a round trip to
+// Sales' gateway at 'addr', and production is reported back over the
+// same connection, coalesced like Sales asked. Log lines go to our
+// own stdout, since factory.log is on Sales' host
+int runRemoteFactory(const char *addr, int capacity, int duration) {
+    int fd = netConnect(addr);
+    if (fd < 0)
+        return 1;
+
+    msgBuf m, pending[MSG_BATCH_MAX];
+    int type;
+    netHello hello = { .version = NET_VERSION, .capacity = capacity, .duration = duration };
+    netWelcome w;
+    if (netSendHello(fd, &hello) < 0 || netRecvWelcome(fd, &w) < 0) {
+        fprintf(stderr, "Remote factory: no welcome from %s\n", addr);
+        close(fd);
+        return 1;
+    }
+    int id = w.facID;
+    int coalesce = w.coalesce;
+    double timeScale = w.timeScale;
+    printf(FMT_FACTORY_STARTED, id, capacity, duration);
+    fflush(stdout);
+
+    int iterations = 0, total_made_by_me = 0, queued = 0;
+    bool lost = false;
+    for (;;) {
+        // Ask the gateway for our next batch
+        if (netSend(fd, NET_CLAIM, NULL, 0) < 0 || netRecv(fd, &type, &m, 1) != 1 || type != NET_GRANT) {
+            lost = true;
+            break;
+        }
+        int to_make = m.partsMade;
+        if (to_make == 0)
+            break;
+
+        printf(FMT_FACTORY_BATCH, id, to_make, duration);
+        fflush(stdout);
+        if (timeScale > 0)
+            Usleep((useconds_t)(duration * 1000 * timeScale));
+
+        msgBuf *p = &pending[queued++];
+        memset(p, 0, sizeof(*p));
+        p->purpose = PRODUCTION_MSG;
+        p->facID = id;
+        p->orderID = m.orderID;
+        p->capacity = capacity;
+        p->partsMade = to_make;
+        p->duration = duration;
+        if (queued >= coalesce) {
+            lost = netSend(fd, NET_REPORT, pending, queued) < 0;
+            queued = 0;
+            if (lost)
+                break;
+        }
+
+        iterations++;
+        total_made_by_me += to_make;
+    }
+
+    // Completion goes out with whatever is still pending
+    if (!lost) {
+        memset(&pending[queued], 0, sizeof(msgBuf));
+        pending[queued].purpose = COMPLETION_MSG;
+        pending[queued].facID = id;
+        lost = netSend(fd, NET_REPORT, pending, queued + 1) < 0;
+    }
+    close(fd);
+    if (lost) {
+        fprintf(stderr, "Remote factory # %d: lost the connection to %s\n", id, addr);
+        return 1;
+    }
+
+    printf(FMT_FACTORY_DONE, id, total_made_by_me, iterations);
+    return 0;
+}
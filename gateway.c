@@ -0,0 +1,266 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+
+#include "wrappers.h"
+#include "message.h"
+#include "shmem.h"
+#include "claim.h"
+#include "transport.h"
+#include "net.h"
+#include "gateway.h"
+
+// How often the acceptor looks at whether there is anything left to
+// wait for while nobody connects
+#define ACCEPT_POLL_MS  100
+
+// One remote factory's connection
+typedef struct {
+    gateway *g;
+    int      fd, id;
+} remoteConn;
+
+// Pass records on to the supervisor, as one batch if there are several
+static void forward(gateway *g, msgBuf *recs, int n) {
+    int rc;
+
+    if (n == 0)
+        return;
+    if (n == 1) {
+        rc = sendMsg(g->shm, g->msgid, &recs[0]);
+    } else {
+        msgBatch b;
+        b.count = n;
+        memcpy(b.recs, recs, n * sizeof(msgBuf));
+        rc = sendBatch(g->shm, g->msgid, &b);
+    }
+    if (rc < 0)
+        perror("gateway msgsnd");
+}
+
+// Tell the supervisor not to wait for factory 'id' any longer
+static void giveUp(gateway *g, int id) {
+    msgBuf bye;
+    memset(&bye, 0, sizeof(bye));
+    bye.mtype = MSG_TYPE_SINGLE;
+    bye.purpose = COMPLETION_MSG;
+    bye.facID = id;
+    bye.queuedNs = Clock_ns();
+    forward(g, &bye, 1);
+}
+
+// Is any open order still holding parts nobody has claimed?
+static bool partsLeft(shData *shm) {
+    for (int i = 0; i < MAXORDERS; i++) {
+        orderSlot *o = &shm->orders[i];
+        if (atomic_load(&o->state) == SLOT_OPEN && orderUnclaimed(shm, o) > 0)
+            return true;
+    }
+    return false;
+}
+
+// Serve one remote factory until it completes or its connection
+// drops. Its claims go through claimParts under its own ID, and
+// each batch it reports lands in its factoryStats entry, so the
+// supervisor, the monitor and checkpoints cannot tell it from a
+// local factory. Reports are restamped on arrival: the remote's
+// clock means nothing here. Parts it claimed but has not reported
+// yet are counted per order slot, so a lost connection can hand
+// them back
+static void *serveRemote(void *arg) {
+    remoteConn *c = arg;
+    gateway *g = c->g;
+    shData *shm = g->shm;
+    int id = c->id;
+    factoryStats *st = shmStats(shm, id);
+    msgBuf recs[MSG_BATCH_MAX], fwd[MSG_BATCH_MAX];
+    netHello hello;
+    int type, n = 0, capacity = 0, duration = 0;
+    int owed[MAXORDERS] = { 0 };
+    bool done = false;
+
+    // HELLO: who we are serving
+    if (netRecvHello(c->fd, &hello) == 0 && hello.version == NET_VERSION) {
+        capacity = hello.capacity;
+        duration = hello.duration;
+        atomic_store(&st->startedNs, Clock_ns());
+        printf("SALES: Remote Factory # %2d connected, with Capacity= %3d and Duration= %4d\n",
+               id, capacity, duration);
+        fflush(stdout);
+
+        netWelcome w = { .facID = id, .coalesce = shm->msgCoalesce, .timeScale = shm->timeScale };
+        if (netSendWelcome(c->fd, &w) < 0)
+            n = -1;
+
+        // Same as runFactory: with stats in shared memory, only
+        // lifecycle events reach the supervisor
+        if (shm->statsInShm) {
+            msgBuf up;
+            memset(&up, 0, sizeof(up));
+            up.mtype = MSG_TYPE_SINGLE;
+            up.purpose = STARTED_MSG;
+            up.facID = id;
+            up.capacity = capacity;
+            up.duration = duration;
+            up.queuedNs = Clock_ns();
+            forward(g, &up, 1);
+        }
+    } else {
+        fprintf(stderr, "SALES: Remote Factory # %2d did not say a valid hello\n", id);
+        n = -1;
+    }
+
+    while (n >= 0 && !done) {
+        n = netRecv(c->fd, &type, recs, MSG_BATCH_MAX);
+        if (n < 0)
+            break;
+
+        if (type == NET_CLAIM) {
+            orderSlot *o = NULL;
+            msgBuf grant;
+            memset(&grant, 0, sizeof(grant));
+            grant.facID = id;
+            grant.partsMade = claimParts(shm, g->sem_shm, shmInstr(shm, id), id, capacity, duration, &o);
+            grant.orderID = grant.partsMade ? o->orderID : 0;
+            if (grant.partsMade)
+                owed[o - shm->orders] += grant.partsMade;
+            if (netSend(c->fd, NET_GRANT, &grant, 1) < 0)
+                n = -1;
+        } else if (type == NET_REPORT) {
+            long long now = Clock_ns();
+            int k = 0;
+            for (int i = 0; i < n; i++) {
+                msgBuf *m = &recs[i];
+                m->mtype = MSG_TYPE_SINGLE;
+                m->facID = id;
+                m->queuedNs = now;
+
+                if (m->purpose == PRODUCTION_MSG) {
+                    orderSlot *o = findOrder(shm, m->orderID);
+                    if (o)
+                        owed[o - shm->orders] -= m->partsMade;
+                    atomic_fetch_add_explicit(&st->parts, m->partsMade, memory_order_relaxed);
+                    atomic_fetch_add_explicit(&st->iters, 1, memory_order_relaxed);
+                    atomic_fetch_add_explicit(&st->busyMs, (long long)(m->duration * shm->timeScale),
+                                              memory_order_relaxed);
+                    atomic_store_explicit(&st->lastNs, now, memory_order_relaxed);
+                    if (shm->statsInShm) {
+                        if (o && atomic_fetch_add(&o->delivered, m->partsMade) + m->partsMade == o->order_size)
+                            completeOrder(shm, o);
+                        continue;
+                    }
+                } else if (m->purpose == COMPLETION_MSG) {
+                    done = true;
+                }
+                fwd[k++] = *m;
+            }
+            forward(g, fwd, k);
+        } else {
+            fprintf(stderr, "SALES: Remote Factory # %2d sent an unknown frame %d\n", id, type);
+            n = -1;
+        }
+    }
+
+    // Whatever it had claimed but not reported goes back to its
+    // order for the factories still at work, and nobody waits for it
+    // any longer
+    if (!done) {
+        int returned = 0;
+        for (int i = 0; i < MAXORDERS; i++)
+            if (owed[i] > 0) {
+                returnParts(shm, g->sem_shm, id, &shm->orders[i], owed[i]);
+                returned += owed[i];
+            }
+        printf("SALES: Remote Factory # %2d was lost before completing its task; %d claimed parts went back to the order\n",
+               id, returned);
+        fflush(stdout);
+        giveUp(g, id);
+    }
+
+    close(c->fd);
+    free(c);
+    return NULL;
+}
+
+// Accept the remote factories, giving each the next ID and a thread.
+// Any that have not connected within g->acceptMs, or by the time the
+// order has nothing left to claim, are given up on
+static void *acceptRemotes(void *arg) {
+    gateway *g = arg;
+    long long deadline = Clock_ns() + g->acceptMs * 1000000LL;
+
+    while (g->accepted < g->count) {
+        long long left = (deadline - Clock_ns()) / 1000000;
+        if (left <= 0 || !partsLeft(g->shm))
+            break;
+
+        struct pollfd p = { .fd = g->listenFd, .events = POLLIN };
+        int r = poll(&p, 1, left < ACCEPT_POLL_MS ? (int)left : ACCEPT_POLL_MS);
+        if (r < 0 && errno != EINTR) {
+            perror("gateway poll");
+            break;
+        }
+        if (r <= 0)
+            continue;
+
+        // A client that gave up before we got to it is not an error
+        int fd = netAccept(g->listenFd);
+        if (fd < 0) {
+            if (errno == ECONNABORTED || errno == EAGAIN || errno == EINTR)
+                continue;
+            perror("gateway accept");
+            break;
+        }
+        remoteConn *c = malloc(sizeof(remoteConn));
+        if (!c) {
+            perror("malloc");
+            close(fd);
+            break;
+        }
+        c->g = g;
+        c->fd = fd;
+        c->id = g->firstID + g->accepted;
+        Pthread_create(&g->conns[g->accepted], NULL, serveRemote, c);
+        g->accepted++;
+    }
+
+    for (int i = g->accepted; i < g->count; i++) {
+        printf("SALES: Remote Factory # %2d never connected; not waiting for it\n", g->firstID + i);
+        giveUp(g, g->firstID + i);
+    }
+    fflush(stdout);
+    return NULL;
+}
+
+// Start accepting remote factories on g->listenFd
+void gatewayStart(gateway *g) {
+    g->accepted = 0;
+    g->conns = calloc(g->count, sizeof(pthread_t));
+    if (!g->conns) {
+        perror("calloc");
+        exit(2);
+    }
+    Pthread_create(&g->acceptor, NULL, acceptRemotes, g);
+}
+
+// Once the supervisor is done every remote factory has completed or
+// been given up on, so all of the gateway's threads are finishing
+void gatewayStop(gateway *g) {
+    Pthread_join(g->acceptor, NULL);
+    for (int i = 0; i < g->accepted; i++)
+        Pthread_join(g->conns[i], NULL);
+    close(g->listenFd);
+    free(g->conns);
+}
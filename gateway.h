@@ -0,0 +1,36 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef GATEWAY_H
+#define GATEWAY_H
+
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "shmem.h"
+
+// Sales' end of the remote factories (--remote / --listen). Factory
+// IDs firstID .. firstID+count-1 are handed out in the order remote
+// factories connect; one thread per connection claims parts and
+// records production for its factory exactly as a local one would,
+// and passes its reports on to the supervisor. Slots nobody has
+// connected to within acceptMs are given up on
+typedef struct
+{
+    shData    *shm ;
+    int        msgid ;
+    sem_t     *sem_shm ;
+    int        listenFd ;
+    int        firstID , count ;
+    int        acceptMs ;       // how long to wait for them all to connect
+    pthread_t  acceptor ;
+    pthread_t *conns ;          // one per remote factory, set as they connect
+    int        accepted ;
+} gateway ;
+
+void gatewayStart( gateway *g ) ;
+void gatewayStop( gateway *g ) ;
+
+#endif
@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "instr.h"
+
+#define LOAD( x )       atomic_load_explicit( &(x) , memory_order_relaxed )
+#define STORE( x , v )  atomic_store_explicit( &(x) , (v) , memory_order_relaxed )
+
+/*--------------------------------------------------------------------
+   Add 'n' to a counter only its owner writes
+----------------------------------------------------------------------*/
+void instrCount( _Atomic long *counter , long n )
+{
+    if ( n != 0 )
+        STORE( *counter , LOAD( *counter ) + n ) ;
+}
+
+/*--------------------------------------------------------------------
+   Add one sample. Only the histogram's owner may call this.
+----------------------------------------------------------------------*/
+void histRecord( histogram *h , long long v )
+{
+    int b = 0 ;
+
+    if ( v < 0 )
+        v = 0 ;
+    if ( v > 0 )
+        b = 63 - __builtin_clzll( (unsigned long long) v ) ;
+    if ( b >= HIST_BUCKETS )
+        b = HIST_BUCKETS - 1 ;
+
+    STORE( h->bucket[b] , LOAD( h->bucket[b] ) + 1 ) ;
+    STORE( h->count , LOAD( h->count ) + 1 ) ;
+    STORE( h->sum , LOAD( h->sum ) + v ) ;
+    if ( v > LOAD( h->max ) )
+        STORE( h->max , v ) ;
+}
+
+/*--------------------------------------------------------------------
+   Fold a snapshot of 'h' into the private histogram 'into'
+----------------------------------------------------------------------*/
+void histMerge( histogram *into , histogram *h )
+{
+    for ( int b = 0 ; b < HIST_BUCKETS ; b++ )
+        STORE( into->bucket[b] , LOAD( into->bucket[b] ) + LOAD( h->bucket[b] ) ) ;
+    STORE( into->count , LOAD( into->count ) + LOAD( h->count ) ) ;
+    STORE( into->sum , LOAD( into->sum ) + LOAD( h->sum ) ) ;
+    if ( LOAD( h->max ) > LOAD( into->max ) )
+        STORE( into->max , LOAD( h->max ) ) ;
+}
+
+/*--------------------------------------------------------------------
+   The p-th percentile (0..100), interpolated linearly inside the
+   bucket it falls in and never above the largest sample seen
+----------------------------------------------------------------------*/
+double histPercentile( histogram *h , double p )
+{
+    long count = 0 ;
+    for ( int b = 0 ; b < HIST_BUCKETS ; b++ )
+        count += LOAD( h->bucket[b] ) ;
+    if ( count == 0 )
+        return 0 ;
+
+    double rank = p / 100.0 * count , seen = 0 ;
+    for ( int b = 0 ; b < HIST_BUCKETS ; b++ )
+    {
+        int n = LOAD( h->bucket[b] ) ;
+        if ( n > 0 && seen + n >= rank )
+        {
+            double lo = ( b == 0 ) ? 0 : (double) ( 1LL << b ) ;
+            double hi = (double) ( 1LL << ( b + 1 ) ) ;
+            double v = lo + ( hi - lo ) * ( rank - seen ) / n ;
+            return ( v > LOAD( h->max ) ) ? (double) LOAD( h->max ) : v ;
+        }
+        seen += n ;
+    }
+    return (double) LOAD( h->max ) ;
+}
+
+//------------------
+
+static void printHist( FILE *out , const char *name , histogram *h , double scale )
+{
+    long n = LOAD( h->count ) ;
+
+    fprintf( out , "  %-16s %9ld %11.1f %11.1f %11.1f %11.1f\n" , name , n ,
+             n ? LOAD( h->sum ) / scale / n : 0.0 ,
+             histPercentile( h , 50 ) / scale , histPercentile( h , 99 ) / scale ,
+             LOAD( h->max ) / scale ) ;
+}
+
+/*--------------------------------------------------------------------
+   Summarize the instrumentation region: factory histograms merged
+   over all factories, then the supervisor's own. Safe to call while
+   the run is still going.
+----------------------------------------------------------------------*/
+void instrReport( FILE *out , procInstr *instr , int nFactories )
+{
+    static procInstr all ;      // too big for a thread's stack
+    long shmBlocked = 0 , logBlocked = 0 , casRetries = 0 , steals = 0 ;
+
+    memset( &all , 0 , sizeof( all ) ) ;
+    for ( int i = 1 ; i <= nFactories ; i++ )
+    {
+        procInstr *p = &instr[i] ;
+        histMerge( &all.shmWait , &p->shmWait ) ;
+        histMerge( &all.shmHold , &p->shmHold ) ;
+        histMerge( &all.logWait , &p->logWait ) ;
+        histMerge( &all.logHold , &p->logHold ) ;
+        histMerge( &all.send    , &p->send ) ;
+        shmBlocked += LOAD( p->shmBlocked ) ;
+        logBlocked += LOAD( p->logBlocked ) ;
+        casRetries += LOAD( p->casRetries ) ;
+        steals     += LOAD( p->steals ) ;
+    }
+
+    fprintf( out , "  %-16s %9s %11s %11s %11s %11s\n" , "(microseconds)" , "count" , "mean" , "p50" , "p99" , "max" ) ;
+    printHist( out , "sem_shm wait" , &all.shmWait , 1e3 ) ;
+    printHist( out , "sem_shm hold" , &all.shmHold , 1e3 ) ;
+    printHist( out , "sem_log wait" , &all.logWait , 1e3 ) ;
+    printHist( out , "sem_log hold" , &all.logHold , 1e3 ) ;
+    printHist( out , "send"         , &all.send    , 1e3 ) ;
+    printHist( out , "delivery"     , &instr[0].deliver , 1e3 ) ;
+    printHist( out , "receive"      , &instr[0].recv    , 1e3 ) ;
+    printHist( out , "queue depth (#)", &instr[0].depth , 1 ) ;
+    fprintf( out , "  Blocked on sem_shm %ld times, on sem_log %ld times; %ld CAS retries, %ld steals\n" ,
+             shmBlocked , logBlocked , casRetries , steals ) ;
+}
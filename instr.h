@@ -0,0 +1,58 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef INSTR_H
+#define INSTR_H
+
+#include <stdio.h>
+#include <stdatomic.h>
+
+#include "ring.h"
+
+// Bucket b counts samples in [ 2^b , 2^(b+1) ), bucket 0 also holds 0.
+// In nanoseconds the last bucket starts at about 9 minutes.
+#define HIST_BUCKETS    40
+
+// Every histogram has exactly one writer, so updates are plain
+// relaxed load + store; readers such as the stats tool may see a
+// sample half recorded, never a torn counter
+typedef struct
+{
+    _Atomic long      count ;
+    _Atomic long long sum ;
+    _Atomic long long max ;
+    _Atomic int       bucket[ HIST_BUCKETS ] ;
+} histogram ;
+
+// One process's (or thread's) counters. Entry 0 of the instrumentation
+// region belongs to the supervisor, entry i to factory i; each starts
+// on its own cache line and is only written by its owner
+typedef struct
+{
+    _Alignas(CACHE_LINE)
+    // Factories
+    histogram shmWait ;         // ns blocked in Sem_wait( sem_shm )
+    histogram shmHold ;         // ns between taking and posting sem_shm
+    histogram logWait ;         // ns blocked in Sem_wait( sem_log )
+    histogram logHold ;         // ns holding sem_log
+    histogram send ;            // ns per msgsnd / ring push of one send
+    _Atomic long shmBlocked ;   // claims that found sem_shm taken
+    _Atomic long logBlocked ;   // log lines that found sem_log taken
+    _Atomic long casRetries ;   // failed CAS attempts on 'remain' or a reservation
+    _Atomic long steals ;       // batches taken from another factory's reservation
+
+    // Supervisor
+    histogram deliver ;         // ns from a factory queueing a message to its receipt
+    histogram recv ;            // ns per msgrcv / ring pop that got a message
+    histogram depth ;           // messages waiting when a drain starts
+} procInstr ;
+
+void   instrCount( _Atomic long *counter , long n ) ;
+void   histRecord( histogram *h , long long v ) ;
+void   histMerge( histogram *into , histogram *h ) ;
+double histPercentile( histogram *h , double p ) ;
+void   instrReport( FILE *out , procInstr *instr , int nFactories ) ;
+
+#endif
@@ -0,0 +1,189 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "wrappers.h"
+#include "logger.h"
+
+#define LOG_MASK    ( LOG_SLOTS - 1 )
+
+/*--------------------------------------------------------------------
+   Writer thread: copy lines out in the order they were reserved,
+   letting stdio batch them into large writes, and flush whenever the
+   buffer runs dry so the log is never far behind
+----------------------------------------------------------------------*/
+static void *logWriter( void *arg )
+{
+    logger *lg = (logger *) arg ;
+
+    for (;;)
+    {
+        logSlot *slot = &lg->slots[ lg->head & LOG_MASK ] ;
+
+        if ( atomic_load_explicit( &slot->seq , memory_order_acquire ) == lg->head + 1 )
+        {
+            if ( lg->tagged )
+                fprintf( lg->out , "[%08ld %10.3f] " , slot->gseq , ( slot->ns - lg->originNs ) / 1e6 ) ;
+            fputs( slot->text , lg->out ) ;
+
+            atomic_store( &slot->seq , lg->head + LOG_SLOTS ) ;
+            lg->head++ ;
+            if ( atomic_load( &lg->producersWaiting ) > 0 )
+            {
+                atomic_fetch_add( &lg->spaceWord , 1 ) ;
+                Futex_wake( (int *) &lg->spaceWord , INT_MAX ) ;
+            }
+            continue ;
+        }
+
+        // Empty: push out what we have, then sleep unless closing
+        fflush( lg->out ) ;
+        int w = atomic_load( &lg->dataWord ) ;
+        atomic_store( &lg->writerIdle , 1 ) ;
+        if ( atomic_load( &slot->seq ) != lg->head + 1 )
+        {
+            if ( atomic_load( &lg->closing ) )
+                break ;
+            Futex_wait( (int *) &lg->dataWord , w ) ;
+        }
+        atomic_store( &lg->writerIdle , 0 ) ;
+    }
+    return NULL ;
+}
+
+/*--------------------------------------------------------------------
+   Start a logger writing to 'out'. 'gseq' numbers lines across
+   processes in LOG_ASYNC_TAGGED mode and may be NULL otherwise.
+----------------------------------------------------------------------*/
+logger *logOpen( FILE *out , int mode , _Atomic long *gseq , long long originNs )
+{
+    logger *lg = aligned_alloc( 64 , sizeof( logger ) ) ;
+    if ( lg == NULL )
+        unix_error( "logOpen failed" ) ;
+
+    memset( lg , 0 , sizeof( logger ) ) ;
+    lg->out = out ;
+    lg->tagged = ( mode == LOG_ASYNC_TAGGED && gseq != NULL ) ;
+    lg->gseq = gseq ;
+    lg->originNs = originNs ;
+    for ( unsigned i = 0 ; i < LOG_SLOTS ; i++ )
+        atomic_init( &lg->slots[i].seq , i ) ;
+
+    Pthread_create( &lg->writer , NULL , logWriter , lg ) ;
+    return lg ;
+}
+
+/*--------------------------------------------------------------------
+   Format one line into the buffer. Never blocks on I/O; only waits
+   if the writer has fallen LOG_SLOTS lines behind.
+----------------------------------------------------------------------*/
+void logVprintf( logger *lg , const char *fmt , va_list ap )
+{
+    logVprintfAt( lg , Clock_ns() , fmt , ap ) ;
+}
+
+/*--------------------------------------------------------------------
+   Same, tagged with 'ns' instead of the time it was logged at
+----------------------------------------------------------------------*/
+void logVprintfAt( logger *lg , long long ns , const char *fmt , va_list ap )
+{
+    unsigned pos = atomic_load_explicit( &lg->tail , memory_order_relaxed ) ;
+    logSlot *slot ;
+
+    for (;;)
+    {
+        slot = &lg->slots[ pos & LOG_MASK ] ;
+        int dif = (int) ( atomic_load_explicit( &slot->seq , memory_order_acquire ) - pos ) ;
+
+        if ( dif == 0 )
+        {
+            if ( atomic_compare_exchange_weak_explicit( &lg->tail , &pos , pos + 1 ,
+                                    memory_order_relaxed , memory_order_relaxed ) )
+                break ;
+        }
+        else if ( dif < 0 )
+        {
+            int w = atomic_load( &lg->spaceWord ) ;
+            atomic_fetch_add( &lg->producersWaiting , 1 ) ;
+            if ( (int) ( atomic_load( &slot->seq ) - pos ) < 0 )
+                Futex_wait( (int *) &lg->spaceWord , w ) ;
+            atomic_fetch_sub( &lg->producersWaiting , 1 ) ;
+            pos = atomic_load_explicit( &lg->tail , memory_order_relaxed ) ;
+        }
+        else
+            pos = atomic_load_explicit( &lg->tail , memory_order_relaxed ) ;
+    }
+
+    vsnprintf( slot->text , LOG_LINE_MAX , fmt , ap ) ;
+
+    slot->ns = ns ;
+    slot->gseq = lg->tagged ? atomic_fetch_add( lg->gseq , 1 ) : 0 ;
+    atomic_store( &slot->seq , pos + 1 ) ;
+
+    if ( atomic_load( &lg->writerIdle ) )
+    {
+        atomic_fetch_add( &lg->dataWord , 1 ) ;
+        Futex_wake( (int *) &lg->dataWord , 1 ) ;
+    }
+}
+
+//------------------
+
+void logPrintf( logger *lg , const char *fmt , ... )
+{
+    va_list ap ;
+    va_start( ap , fmt ) ;
+    logVprintf( lg , fmt , ap ) ;
+    va_end( ap ) ;
+}
+
+/*--------------------------------------------------------------------
+   Drain everything logged so far, stop the writer and free the logger
+----------------------------------------------------------------------*/
+void logClose( logger *lg )
+{
+    atomic_store( &lg->closing , 1 ) ;
+    atomic_fetch_add( &lg->dataWord , 1 ) ;
+    Futex_wake( (int *) &lg->dataWord , 1 ) ;
+
+    Pthread_join( lg->writer , NULL ) ;
+    fflush( lg->out ) ;
+    free( lg ) ;
+}
+
+/*--------------------------------------------------------------------
+   Convert log modes to / from their command-line names
+----------------------------------------------------------------------*/
+const char *logModeName( int mode )
+{
+    switch ( mode )
+    {
+    case LOG_ASYNC:        return "async" ;
+    case LOG_ASYNC_TAGGED: return "async-tagged" ;
+    case LOG_BINARY:       return "binary" ;
+    default:               return "sync" ;
+    }
+}
+
+int logModeFromName( const char *name )
+{
+    if ( strcmp( name , "sync" ) == 0 )
+        return LOG_SYNC ;
+    if ( strcmp( name , "async" ) == 0 )
+        return LOG_ASYNC ;
+    if ( strcmp( name , "async-tagged" ) == 0 )
+        return LOG_ASYNC_TAGGED ;
+    if ( strcmp( name , "binary" ) == 0 )
+        return LOG_BINARY ;
+    return -1 ;
+}
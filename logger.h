@@ -0,0 +1,66 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// How factories write factory.log
+typedef enum
+{
+    LOG_SYNC = 0 ,          // printf + fflush under sem_log, one write() per line
+    LOG_ASYNC ,             // lock-free buffer drained by a writer thread, same lines
+    LOG_ASYNC_TAGGED ,      // as LOG_ASYNC, each line prefixed with "[seq time_ms]"
+    LOG_BINARY              // fixed-size records in *.trace, decoded by tracedump
+} logMode_t ;
+
+#define LOG_LINE_MAX    160     // longer lines are truncated
+#define LOG_SLOTS       4096    // power of two
+
+typedef struct
+{
+    _Atomic unsigned  seq ;     // same protocol as ringSlot
+    long              gseq ;    // global sequence number (tagged mode)
+    long long         ns ;      // CLOCK_MONOTONIC when the line was logged
+    char              text[ LOG_LINE_MAX ] ;
+} logSlot ;
+
+// Multi-producer buffer of formatted lines, owned by one process and
+// drained by that process' writer thread
+typedef struct
+{
+    FILE             *out ;
+    int               tagged ;
+    _Atomic long     *gseq ;        // counter shared by every process, for tags
+    long long         originNs ;    // tag times are relative to this
+
+    _Alignas(64)
+    _Atomic unsigned  tail ;
+    _Atomic int       producersWaiting ;
+    _Atomic int       dataWord ;
+
+    _Alignas(64)
+    unsigned          head ;
+    _Atomic int       writerIdle ;
+    _Atomic int       spaceWord ;
+    _Atomic int       closing ;
+
+    pthread_t         writer ;
+    logSlot           slots[ LOG_SLOTS ] ;
+} logger ;
+
+logger *logOpen( FILE *out , int mode , _Atomic long *gseq , long long originNs ) ;
+void    logVprintf( logger *lg , const char *fmt , va_list ap ) ;
+void    logVprintfAt( logger *lg , long long ns , const char *fmt , va_list ap ) ;
+void    logPrintf( logger *lg , const char *fmt , ... ) ;
+void    logClose( logger *lg ) ;
+const char *logModeName( int mode ) ;
+int     logModeFromName( const char *name ) ;
+
+#endif
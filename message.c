@@ -12,8 +12,8 @@
 ----------------------------------------------------------------------*/
 void printMsg( msgBuf *m )
 {
-    printf( "{type=%ld, (Purpose=%d, FacID %3d, Capacity %3d, Parts %3d, duration %4d) }\n"
-       , m->mtype    , m->purpose   , m->facID 
+    printf( "{type=%ld, (Purpose=%d, FacID %3d, Order %3d, Capacity %3d, Parts %3d, duration %4d) }\n"
+       , m->mtype    , m->purpose   , m->facID     , m->orderID
        , m->capacity , m->partsMade , m->duration  ) ;
 }
 
@@ -3,26 +3,52 @@
 // Date       :
 // Author     : Mohamed Aboutabl
 //----------------------------------------------------------------------
+#ifndef MESSAGE_H
+#define MESSAGE_H
+
+#include <stddef.h>
 #include <sys/types.h>
 
 typedef enum 
 {
-    PRODUCTION_MSG = 1 , COMPLETION_MSG 
+    PRODUCTION_MSG = 1 , COMPLETION_MSG , STARTED_MSG 
 } msgPurpose_t;
 
+/* mtype tells single messages and batches apart on the queue */
+#define MSG_TYPE_SINGLE   1
+#define MSG_TYPE_BATCH    2
+
 typedef struct {
-    long mtype ;               /* not used here */
+    long mtype ;               /* MSG_TYPE_SINGLE */
 
     msgPurpose_t  purpose ;  /* Purpose of this message to Supervisor */
 
     int  facID    ,          /* sender's Factory ID */
+         orderID  ,          /* order these parts belong to (stream mode) */
          capacity ,          /* #of parts made in most recent iteration */
          partsMade ,         /* #of parts made in most recent iteration */
          duration ;          /* how long it took to make them */
 
+    long long queuedNs ;     /* CLOCK_MONOTONIC when the factory queued it */
+    long long simNs ;        /* --sim: the factory's virtual clock when it queued it */
+
 } msgBuf ;
 
 #define MSG_INFO_SIZE ( sizeof(msgBuf) - sizeof(long) )
 
+/* Several messages from one factory coalesced into a single send.
+   Each record is a full msgBuf whose own mtype is not used. */
+#define MSG_BATCH_MAX   32
+
+typedef struct {
+    long   mtype ;             /* MSG_TYPE_BATCH */
+    int    count ;             /* #records in use */
+    msgBuf recs[ MSG_BATCH_MAX ] ;
+} msgBatch ;
+
+/* Only the records in use are sent */
+#define MSG_BATCH_SIZE( n ) ( offsetof( msgBatch , recs ) - sizeof(long) + (n) * sizeof(msgBuf) )
+
 void printMsg( msgBuf *m ) ;
 
+#endif
@@ -0,0 +1,166 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+// Live progress of a running Sales: open orders with made/remain,
+// every factory's rate, and an ETA for what is still outstanding.
+// Attaches read-only to the segment of run run_id (the "Run ID" Sales
+// printed; optional while only one run is up) and only ever loads
+// counters; it takes none of the semaphores the factories use.
+// Thread-mode runs keep shData in-process and cannot be watched this
+// way.
+//
+// Usage: monitor [-i interval_ms] [-n count] [-f max_factory_rows] [-r run_id]
+//----------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <pthread.h>
+
+#include "wrappers.h"
+#include "shmem.h"
+#include "claim.h"
+
+// Seconds, printed as "12.3 s" or "--" if unknown
+static void print_eta(double sec) {
+    if (sec < 0)
+        printf("%10s", "--");
+    else
+        printf("%8.1f s", sec);
+}
+
+int main(int argc, char **argv) {
+    int interval = 1000, count = 0, rows = 20, runID = 0, opt;
+
+    while ((opt = getopt(argc, argv, "i:n:f:r:")) != -1) {
+        switch (opt) {
+        case 'i':
+            interval = atoi(optarg);
+            break;
+        case 'n':
+            count = atoi(optarg);
+            break;
+        case 'f':
+            rows = atoi(optarg);
+            break;
+        case 'r':
+            runID = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-i interval_ms] [-n count] [-f max_factory_rows] [-r run_id]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (interval <= 0) {
+        fprintf(stderr, "interval must be positive\n");
+        return 1;
+    }
+
+    // Same key Sales uses; without -r, the only run there is
+    if (runID == 0)
+        runID = shmemFindRun();
+    if (runID < 0) {
+        fprintf(stderr, "Several Sales runs are up; pick one with -r run_id\n");
+        return 1;
+    }
+    key_t key = shmemKey(runID, 'S');
+    int shmid;
+    shData *shm = runID ? shmemWatch(key, &shmid) : NULL;
+    if (!shm) {
+        fprintf(stderr, "No Sales run to watch\n");
+        return 1;
+    }
+
+    // Parts each factory had made at the previous refresh, for rates
+    int N = shm->nFactories;
+    int *prev = calloc(N + 1, sizeof(int));
+    if (!prev) {
+        perror("calloc");
+        return 2;
+    }
+    long long prevNs = Clock_ns();
+    bool tty = isatty(STDOUT_FILENO);
+
+    for (int i = 1; count == 0 || i <= count; i++) {
+        long long nowNs = Clock_ns();
+        double since = shm->startNs ? (nowNs - shm->startNs) / 1e9 : 0;
+        double dt = (nowNs - prevNs) / 1e9;
+
+        // On a terminal, redraw in place
+        if (tty)
+            printf("\033[H\033[2J");
+        printf("\n****** MONITOR: %.1f s after launch, %d of %d factories active ******\n",
+               since, shm->activeFactories, N);
+
+        // Everything produced so far, and how fast over the last interval
+        long made = 0, recent = 0;
+        for (int f = 1; f <= N; f++) {
+            int p = atomic_load_explicit(&shmStats(shm, f)->parts, memory_order_relaxed);
+            made += p;
+            recent += p - prev[f];
+        }
+        double rate = (i > 1 && dt > 0) ? recent / dt : (since > 0 ? made / since : 0);
+        long left = shm->totalOrdered - made;
+        printf("Made %ld of %d parts ordered (%.1f%%), %.1f parts/s, ETA ",
+               made, shm->totalOrdered, shm->totalOrdered ? 100.0 * made / shm->totalOrdered : 0.0, rate);
+        print_eta(left <= 0 ? 0 : (rate > 0 ? left / rate : -1));
+        printf("\n");
+
+        // Open orders. 'claimed' is handed out to factories, 'remain'
+        // is still up for grabs; claims ahead of production show as
+        // claimed parts not yet made
+        printf("\nOrder    size   claimed    remain  deadline\n");
+        for (int s = 0; s < MAXORDERS; s++) {
+            orderSlot *o = &shm->orders[s];
+            if (atomic_load(&o->state) != SLOT_OPEN)
+                continue;
+            int remain = orderUnclaimed(shm, o);
+            printf("%5d %7d %9d %9d  ", o->orderID, o->order_size, o->order_size - remain, remain);
+            if (o->deadline == NO_DEADLINE)
+                printf("%8s\n", "--");
+            else
+                printf("%6d ms\n", o->deadline);
+        }
+
+        // Factories; rate is over the last interval, average since launch
+        printf("\nFactory   parts  iters  busy%%    parts/s   average/s   last batch\n");
+        for (int f = 1; f <= N; f++) {
+            factoryStats *st = shmStats(shm, f);
+            int p = atomic_load_explicit(&st->parts, memory_order_relaxed);
+            if (f <= rows) {
+                long long last = atomic_load_explicit(&st->lastNs, memory_order_relaxed);
+                long long busy = atomic_load_explicit(&st->busyMs, memory_order_relaxed);
+                printf("%7d %7d %6d %5.1f %10.1f %11.1f ", f, p,
+                       atomic_load_explicit(&st->iters, memory_order_relaxed),
+                       since > 0 ? 100.0 * busy / (since * 1e3) : 0.0,
+                       (i > 1 && dt > 0) ? (p - prev[f]) / dt : 0.0,
+                       since > 0 ? p / since : 0.0);
+                if (last)
+                    printf("%8.1f s ago\n", (nowNs - last) / 1e9);
+                else
+                    printf("%14s\n", "--");
+            }
+            prev[f] = p;
+        }
+        if (N > rows)
+            printf("... %d more factories (-f to show them)\n", N - rows);
+        fflush(stdout);
+        prevNs = nowNs;
+
+        // Sales removed the segment: this was the last look
+        if (shmemGone(key, shmid))
+            break;
+        Usleep((useconds_t)interval * 1000);
+    }
+
+    free(prev);
+    Shmdt(shm);
+    return 0;
+}
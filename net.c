@@ -0,0 +1,321 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "wrappers.h"
+#include "net.h"
+
+#define UNIX_PREFIX     "unix:"
+
+/*--------------------------------------------------------------------
+   A Unix-domain address for "unix:PATH", or -1 if 'addr' is not one
+----------------------------------------------------------------------*/
+static int unixAddr( const char *addr , struct sockaddr_un *sun )
+{
+    if ( strncmp( addr , UNIX_PREFIX , strlen( UNIX_PREFIX ) ) != 0 )
+        return -1 ;
+
+    const char *path = addr + strlen( UNIX_PREFIX ) ;
+    memset( sun , 0 , sizeof( *sun ) ) ;
+    sun->sun_family = AF_UNIX ;
+    if ( strlen( path ) >= sizeof( sun->sun_path ) )
+    {
+        fprintf( stderr , "%s: socket path too long\n" , path ) ;
+        exit( 1 ) ;
+    }
+    strcpy( sun->sun_path , path ) ;
+    return 0 ;
+}
+
+/*--------------------------------------------------------------------
+   Resolve "HOST:PORT" or "PORT" for TCP. The caller frees the list.
+----------------------------------------------------------------------*/
+static struct addrinfo *tcpAddrs( const char *addr , int passive )
+{
+    char host[ 256 ] = "" ;
+    const char *port = addr , *colon = strrchr( addr , ':' ) ;
+    if ( colon )
+    {
+        snprintf( host , sizeof( host ) , "%.*s" , (int) ( colon - addr ) , addr ) ;
+        port = colon + 1 ;
+    }
+
+    struct addrinfo hints , *res ;
+    memset( &hints , 0 , sizeof( hints ) ) ;
+    hints.ai_family = AF_UNSPEC ;
+    hints.ai_socktype = SOCK_STREAM ;
+    hints.ai_flags = passive ? AI_PASSIVE : 0 ;
+
+    int rc = getaddrinfo( host[0] ? host : NULL , port , &hints , &res ) ;
+    if ( rc != 0 )
+    {
+        fprintf( stderr , "%s: %s\n" , addr , gai_strerror( rc ) ) ;
+        return NULL ;
+    }
+    return res ;
+}
+
+/*--------------------------------------------------------------------
+   Frames are small and each one is waited on, so never hold one back
+----------------------------------------------------------------------*/
+static void noDelay( int fd , int family )
+{
+    int one = 1 ;
+    if ( family != AF_UNIX )
+        setsockopt( fd , IPPROTO_TCP , TCP_NODELAY , &one , sizeof( one ) ) ;
+}
+
+/*--------------------------------------------------------------------
+   Sales: listen on 'addr' for remote factories. The socket is
+   close-on-exec, so local factories never inherit it.
+   Returns the listening socket, or -1.
+----------------------------------------------------------------------*/
+int netListen( const char *addr )
+{
+    struct sockaddr_un sun ;
+    if ( unixAddr( addr , &sun ) == 0 )
+    {
+        int fd = socket( AF_UNIX , SOCK_STREAM | SOCK_CLOEXEC , 0 ) ;
+        unlink( sun.sun_path ) ;    // left behind by an earlier run
+        if ( fd < 0 || bind( fd , (struct sockaddr *) &sun , sizeof( sun ) ) < 0
+             || listen( fd , SOMAXCONN ) < 0 )
+        {
+            perror( addr ) ;
+            if ( fd >= 0 )
+                close( fd ) ;
+            return -1 ;
+        }
+        return fd ;
+    }
+
+    struct addrinfo *res = tcpAddrs( addr , 1 ) , *ai ;
+    int fd = -1 ;
+    for ( ai = res ; ai && fd < 0 ; ai = ai->ai_next )
+    {
+        int one = 1 ;
+        fd = socket( ai->ai_family , ai->ai_socktype | SOCK_CLOEXEC , ai->ai_protocol ) ;
+        if ( fd < 0 )
+            continue ;
+        setsockopt( fd , SOL_SOCKET , SO_REUSEADDR , &one , sizeof( one ) ) ;
+        if ( bind( fd , ai->ai_addr , ai->ai_addrlen ) < 0 || listen( fd , SOMAXCONN ) < 0 )
+        {
+            close( fd ) ;
+            fd = -1 ;
+        }
+    }
+    if ( fd < 0 && res )
+        perror( addr ) ;
+    if ( res )
+        freeaddrinfo( res ) ;
+    return fd ;
+}
+
+/*--------------------------------------------------------------------
+   Sales: the next remote factory to connect. Returns its socket,
+   close-on-exec like the listener, or -1.
+----------------------------------------------------------------------*/
+int netAccept( int lfd )
+{
+    struct sockaddr_storage ss ;
+    socklen_t len = sizeof( ss ) ;
+
+    int fd ;
+    while ( ( fd = accept( lfd , (struct sockaddr *) &ss , &len ) ) < 0 && errno == EINTR )
+        ;
+    if ( fd < 0 )
+        return -1 ;
+    fcntl( fd , F_SETFD , FD_CLOEXEC ) ;
+    noDelay( fd , ss.ss_family ) ;
+    return fd ;
+}
+
+/*--------------------------------------------------------------------
+   Remote factory: connect to Sales' gateway. Returns the socket, or -1.
+----------------------------------------------------------------------*/
+int netConnect( const char *addr )
+{
+    struct sockaddr_un sun ;
+    if ( unixAddr( addr , &sun ) == 0 )
+    {
+        int fd = socket( AF_UNIX , SOCK_STREAM | SOCK_CLOEXEC , 0 ) ;
+        if ( fd < 0 || connect( fd , (struct sockaddr *) &sun , sizeof( sun ) ) < 0 )
+        {
+            perror( addr ) ;
+            if ( fd >= 0 )
+                close( fd ) ;
+            return -1 ;
+        }
+        return fd ;
+    }
+
+    struct addrinfo *res = tcpAddrs( addr , 0 ) , *ai ;
+    int fd = -1 ;
+    for ( ai = res ; ai && fd < 0 ; ai = ai->ai_next )
+    {
+        fd = socket( ai->ai_family , ai->ai_socktype | SOCK_CLOEXEC , ai->ai_protocol ) ;
+        if ( fd < 0 )
+            continue ;
+        if ( connect( fd , ai->ai_addr , ai->ai_addrlen ) < 0 )
+        {
+            close( fd ) ;
+            fd = -1 ;
+        }
+        else
+            noDelay( fd , ai->ai_family ) ;
+    }
+    if ( fd < 0 && res )
+        perror( addr ) ;
+    if ( res )
+        freeaddrinfo( res ) ;
+    return fd ;
+}
+
+/*--------------------------------------------------------------------
+   Sales: remove a Unix-domain socket once nobody will connect to it
+----------------------------------------------------------------------*/
+void netUnlink( const char *addr )
+{
+    struct sockaddr_un sun ;
+    if ( unixAddr( addr , &sun ) == 0 )
+        unlink( sun.sun_path ) ;
+}
+
+/*--------------------------------------------------------------------
+   Send a header for 'count' records and the 'size' bytes they take
+   at 'p' as one write. A closed peer is an error return, not a
+   SIGPIPE. Returns 0, or -1 (with errno set).
+----------------------------------------------------------------------*/
+static int sendFrame( int fd , int type , int count , const void *p , size_t size )
+{
+    char buf[ sizeof( netHeader ) + MSG_BATCH_MAX * sizeof( msgBuf ) ] ;
+    netHeader h = { (uint32_t) type , (uint32_t) count } ;
+
+    memcpy( buf , &h , sizeof( h ) ) ;
+    if ( size > 0 )
+        memcpy( buf + sizeof( h ) , p , size ) ;
+
+    size_t len = sizeof( h ) + size , off = 0 ;
+    while ( off < len )
+    {
+        ssize_t n = send( fd , buf + off , len - off , MSG_NOSIGNAL ) ;
+        if ( n < 0 )
+        {
+            if ( errno == EINTR )
+                continue ;
+            return -1 ;
+        }
+        off += n ;
+    }
+    return 0 ;
+}
+
+/*--------------------------------------------------------------------
+   Send one frame of 'count' msgBufs. Returns 0, or -1 (errno set).
+----------------------------------------------------------------------*/
+int netSend( int fd , int type , msgBuf *recs , int count )
+{
+    if ( count < 0 || count > MSG_BATCH_MAX )
+    {
+        errno = EINVAL ;
+        return -1 ;
+    }
+    return sendFrame( fd , type , count , recs , count * sizeof( msgBuf ) ) ;
+}
+
+/*--------------------------------------------------------------------
+   Read exactly 'len' bytes. Returns 0, or -1 on EOF or an error.
+----------------------------------------------------------------------*/
+static int readAll( int fd , void *p , size_t len )
+{
+    char *c = p ;
+
+    while ( len > 0 )
+    {
+        ssize_t n = read( fd , c , len ) ;
+        if ( n < 0 && errno == EINTR )
+            continue ;
+        if ( n <= 0 )
+            return -1 ;
+        c += n ;
+        len -= n ;
+    }
+    return 0 ;
+}
+
+/*--------------------------------------------------------------------
+   Receive one frame into 'recs' (room for 'max'). Returns the number
+   of records, or -1 once the peer is gone or sent a bad frame.
+----------------------------------------------------------------------*/
+int netRecv( int fd , int *type , msgBuf *recs , int max )
+{
+    netHeader h ;
+
+    if ( readAll( fd , &h , sizeof( h ) ) < 0 )
+        return -1 ;
+    if ( h.count > (uint32_t) max )
+    {
+        fprintf( stderr , "Bad frame: %u records, at most %d expected\n" , h.count , max ) ;
+        return -1 ;
+    }
+    if ( readAll( fd , recs , h.count * sizeof( msgBuf ) ) < 0 )
+        return -1 ;
+
+    *type = (int) h.type ;
+    return (int) h.count ;
+}
+
+/*--------------------------------------------------------------------
+   Receive a frame that must be 'type' with a single 'size'-byte
+   record. Returns 0, or -1 once the peer is gone or sent another.
+----------------------------------------------------------------------*/
+static int recvOne( int fd , int type , void *p , size_t size )
+{
+    netHeader h ;
+
+    if ( readAll( fd , &h , sizeof( h ) ) < 0 )
+        return -1 ;
+    if ( h.type != (uint32_t) type || h.count != 1 )
+    {
+        fprintf( stderr , "Bad frame: type %u with %u records, expected type %d\n" , h.type , h.count , type ) ;
+        return -1 ;
+    }
+    return readAll( fd , p , size ) ;
+}
+
+//------------------
+
+int netSendHello( int fd , const netHello *h )
+{
+    return sendFrame( fd , NET_HELLO , 1 , h , sizeof( *h ) ) ;
+}
+
+int netRecvHello( int fd , netHello *h )
+{
+    return recvOne( fd , NET_HELLO , h , sizeof( *h ) ) ;
+}
+
+int netSendWelcome( int fd , const netWelcome *w )
+{
+    return sendFrame( fd , NET_WELCOME , 1 , w , sizeof( *w ) ) ;
+}
+
+int netRecvWelcome( int fd , netWelcome *w )
+{
+    return recvOne( fd , NET_WELCOME , w , sizeof( *w ) ) ;
+}
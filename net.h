@@ -0,0 +1,67 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef NET_H
+#define NET_H
+
+#include <stdint.h>
+
+#include "message.h"
+
+// A remote factory talks to Sales' gateway (gateway.c) over one TCP
+// or Unix-domain connection. Every frame is a netHeader followed by
+// 'count' records, sent with a single write. Records are sent as they
+// are in memory, so both ends must be built from the same tree for
+// the same architecture; HELLO carries NET_VERSION to catch a
+// mismatch.
+//
+//   factory -> gateway   NET_HELLO    1 netHello
+//   gateway -> factory   NET_WELCOME  1 netWelcome
+//   factory -> gateway   NET_CLAIM    no records
+//   gateway -> factory   NET_GRANT    1 msgBuf: orderID, partsMade =
+//                                     parts claimed, 0 once none are left
+//   factory -> gateway   NET_REPORT   up to MSG_BATCH_MAX PRODUCTION /
+//                                     COMPLETION msgBufs
+#define NET_VERSION     3
+
+typedef enum
+{
+    NET_HELLO = 1 , NET_WELCOME , NET_CLAIM , NET_GRANT , NET_REPORT
+} netFrame_t ;
+
+typedef struct
+{
+    uint32_t type ;             // one of netFrame_t
+    uint32_t count ;            // msgBufs that follow
+} netHeader ;
+
+// A remote factory introducing itself
+typedef struct
+{
+    uint32_t version ;          // NET_VERSION
+    int32_t  capacity , duration ;
+} netHello ;
+
+// What the gateway tells it back
+typedef struct
+{
+    int32_t  facID ;            // the ID it runs under
+    int32_t  coalesce ;         // reports per send, as Sales' --coalesce
+    double   timeScale ;        // Sales' --time-scale
+} netWelcome ;
+
+// Addresses are "unix:PATH", "HOST:PORT" or just "PORT" (any interface)
+int  netListen( const char *addr ) ;
+int  netAccept( int lfd ) ;
+int  netConnect( const char *addr ) ;
+void netUnlink( const char *addr ) ;
+int  netSend( int fd , int type , msgBuf *recs , int count ) ;
+int  netRecv( int fd , int *type , msgBuf *recs , int max ) ;
+int  netSendHello( int fd , const netHello *h ) ;
+int  netRecvHello( int fd , netHello *h ) ;
+int  netSendWelcome( int fd , const netWelcome *w ) ;
+int  netRecvWelcome( int fd , netWelcome *w ) ;
+
+#endif
@@ -0,0 +1,186 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+// Where factories, the supervisor and the shared segment live:
+// CPU pinning through sched_setaffinity and NUMA memory policy
+// through the mbind system call (no libnuma needed).
+//----------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+
+#include "wrappers.h"
+#include "placement.h"
+
+// From <linux/mempolicy.h>
+#define MPOL_BIND           2
+#define MPOL_INTERLEAVE     3
+
+// Largest node number numaBind can address
+#define MAX_NODES           ( 8 * (int) sizeof( unsigned long ) )
+
+/*--------------------------------------------------------------------
+   The CPUs this process may run on, in ascending order. Fills at
+   most 'max' entries and returns how many there are.
+----------------------------------------------------------------------*/
+int placementCpus( int *cpus , int max )
+{
+    cpu_set_t set ;
+    int n = 0 ;
+
+    if ( sched_getaffinity( 0 , sizeof( set ) , &set ) < 0 )
+        unix_error( "sched_getaffinity failed" ) ;
+    for ( int c = 0 ; c < CPU_SETSIZE && n < max ; c++ )
+        if ( CPU_ISSET( c , &set ) )
+            cpus[ n++ ] = c ;
+    return n ;
+}
+
+/*--------------------------------------------------------------------
+   The CPU factory 'facID' belongs on: round-robin over the CPUs Sales
+   may use, leaving out the supervisor's if there are others. Every
+   factory starts with Sales' mask, so each works out the same list.
+   Returns -1 when factories are not pinned.
+----------------------------------------------------------------------*/
+int placementFactoryCpu( shData *shm , int facID )
+{
+    int cpus[ CPU_SETSIZE ] , all[ CPU_SETSIZE ] ;
+    int n = 0 , total ;
+
+    if ( !shm->pinFactories )
+        return -1 ;
+
+    total = placementCpus( all , CPU_SETSIZE ) ;
+    for ( int i = 0 ; i < total ; i++ )
+        if ( all[i] != shm->supervisorCpu || total == 1 )
+            cpus[ n++ ] = all[i] ;
+    return cpus[ ( facID - 1 ) % n ] ;
+}
+
+/*--------------------------------------------------------------------
+   Pin the calling thread to 'cpu'. Returns 0, or -1 with errno set.
+----------------------------------------------------------------------*/
+int pinSelf( int cpu )
+{
+    cpu_set_t set ;
+
+    CPU_ZERO( &set ) ;
+    CPU_SET( cpu , &set ) ;
+    return sched_setaffinity( 0 , sizeof( set ) , &set ) ;
+}
+
+/*--------------------------------------------------------------------
+   How many NUMA nodes the machine has (1 without NUMA support)
+----------------------------------------------------------------------*/
+int numaNodes( void )
+{
+    char path[64] ;
+    int n = 0 ;
+
+    for ( ;; )
+    {
+        snprintf( path , sizeof( path ) , "/sys/devices/system/node/node%d" , n ) ;
+        if ( access( path , F_OK ) != 0 )
+            break ;
+        n++ ;
+    }
+    return n ? n : 1 ;
+}
+
+/*--------------------------------------------------------------------
+   Place the pages of [ addr , addr + len ) on NUMA node 'node', or
+   spread them over every node for NUMA_INTERLEAVE. 'addr' must be
+   page aligned, and only pages not touched yet are placed.
+   Returns 0, or -1 with errno set.
+----------------------------------------------------------------------*/
+int numaBind( void *addr , size_t len , int node )
+{
+    unsigned long mask = 0 ;
+    int mode = MPOL_BIND ;
+
+    if ( node == NUMA_INTERLEAVE )
+    {
+        int nodes = numaNodes() ;
+        mode = MPOL_INTERLEAVE ;
+        for ( int i = 0 ; i < nodes && i < MAX_NODES ; i++ )
+            mask |= 1UL << i ;
+    }
+    else if ( node >= 0 && node < MAX_NODES )
+        mask = 1UL << node ;
+    else
+    {
+        errno = EINVAL ;
+        return -1 ;
+    }
+
+    return (int) syscall( SYS_mbind , addr , len , mode , &mask , MAX_NODES + 1 , 0 ) ;
+}
+
+//------------------
+// "0-3,6" for the ascending CPU list cpus[ 0 .. n-1 ]
+
+static void printCpuList( FILE *out , int *cpus , int n )
+{
+    for ( int i = 0 ; i < n ; )
+    {
+        int j = i ;
+        while ( j + 1 < n && cpus[ j + 1 ] == cpus[j] + 1 )
+            j++ ;
+        fprintf( out , "%s%d" , i ? "," : "" , cpus[i] ) ;
+        if ( j > i )
+            fprintf( out , "-%d" , cpus[j] ) ;
+        i = j + 1 ;
+    }
+}
+
+/*--------------------------------------------------------------------
+   One line for the final report: where everything actually ran
+----------------------------------------------------------------------*/
+void placementReport( FILE *out , shData *shm )
+{
+    static int used[ CPU_SETSIZE ] ;
+    int n = 0 ;
+    char seen[ CPU_SETSIZE ] = { 0 } ;
+
+    // Distinct CPUs the factories pinned themselves to
+    for ( int i = 1 ; i <= shm->nFactories ; i++ )
+    {
+        int c = shmStats( shm , i )->cpu ;
+        if ( c >= 0 && c < CPU_SETSIZE && !seen[c] )
+            seen[c] = 1 ;
+    }
+    for ( int c = 0 ; c < CPU_SETSIZE ; c++ )
+        if ( seen[c] )
+            used[ n++ ] = c ;
+
+    fprintf( out , "Placement: supervisor " ) ;
+    if ( shm->supervisorCpu >= 0 )
+        fprintf( out , "on CPU %d" , shm->supervisorCpu ) ;
+    else
+        fprintf( out , "not pinned" ) ;
+
+    fprintf( out , ", factories " ) ;
+    if ( n > 0 )
+    {
+        fprintf( out , "round-robin on CPUs " ) ;
+        printCpuList( out , used , n ) ;
+    }
+    else
+        fprintf( out , "not pinned" ) ;
+
+    fprintf( out , ", shared memory " ) ;
+    if ( shm->shmNuma == NUMA_INTERLEAVE )
+        fprintf( out , "interleaved over %d NUMA nodes\n" , numaNodes() ) ;
+    else if ( shm->shmNuma >= 0 )
+        fprintf( out , "on NUMA node %d\n" , shm->shmNuma ) ;
+    else
+        fprintf( out , "placed by first touch\n" ) ;
+}
@@ -0,0 +1,21 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "shmem.h"
+
+int  placementCpus( int *cpus , int max ) ;
+int  placementFactoryCpu( shData *shm , int facID ) ;
+int  pinSelf( int cpu ) ;
+int  numaNodes( void ) ;
+int  numaBind( void *addr , size_t len , int node ) ;
+void placementReport( FILE *out , shData *shm ) ;
+
+#endif
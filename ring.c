@@ -0,0 +1,136 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "wrappers.h"
+#include "ring.h"
+
+#define RING_MASK   ( r->nslots - 1 )
+
+/*--------------------------------------------------------------------
+   Size the ring so every factory can have a few reports in flight
+   without ever parking on a full ring
+----------------------------------------------------------------------*/
+unsigned ringSlotsFor( int nFactories )
+{
+    unsigned n = RING_MIN_SLOTS ;
+    while ( n < 4u * (unsigned) nFactories )
+        n <<= 1 ;
+    return n ;
+}
+
+size_t ringBytes( unsigned nslots )
+{
+    return sizeof( msgRing ) + nslots * sizeof( ringSlot ) ;
+}
+
+/*--------------------------------------------------------------------
+   Initialize an empty ring. Must run before any producer starts.
+----------------------------------------------------------------------*/
+void ringInit( msgRing *r , unsigned nslots )
+{
+    atomic_init( &r->tail , 0 ) ;
+    r->head = 0 ;
+    atomic_init( &r->consumerIdle , 0 ) ;
+    atomic_init( &r->dataWord , 0 ) ;
+    atomic_init( &r->producersWaiting , 0 ) ;
+    atomic_init( &r->spaceWord , 0 ) ;
+    r->nslots = nslots ;
+
+    for ( unsigned i = 0 ; i < nslots ; i++ )
+        atomic_init( &r->slots[i].seq , i ) ;
+}
+
+/*--------------------------------------------------------------------
+   Producer side: reserve a slot, copy the message in, publish it and
+   wake the consumer only if it went to sleep.
+----------------------------------------------------------------------*/
+void ringSend( msgRing *r , const msgBuf *m )
+{
+    unsigned pos = atomic_load_explicit( &r->tail , memory_order_relaxed ) ;
+    ringSlot *slot ;
+
+    for (;;)
+    {
+        slot = &r->slots[ pos & RING_MASK ] ;
+        unsigned seq = atomic_load_explicit( &slot->seq , memory_order_acquire ) ;
+        int      dif = (int)( seq - pos ) ;
+
+        if ( dif == 0 )
+        {
+            // Slot is free, race the other producers for it
+            if ( atomic_compare_exchange_weak_explicit( &r->tail , &pos , pos + 1 ,
+                                    memory_order_relaxed , memory_order_relaxed ) )
+                break ;
+        }
+        else if ( dif < 0 )
+        {
+            // Ring is full: park until the consumer frees something
+            int w = atomic_load( &r->spaceWord ) ;
+            atomic_fetch_add( &r->producersWaiting , 1 ) ;
+            if ( (int)( atomic_load( &slot->seq ) - pos ) < 0 )
+                Futex_wait( (int *) &r->spaceWord , w ) ;
+            atomic_fetch_sub( &r->producersWaiting , 1 ) ;
+            pos = atomic_load_explicit( &r->tail , memory_order_relaxed ) ;
+        }
+        else
+            pos = atomic_load_explicit( &r->tail , memory_order_relaxed ) ;
+    }
+
+    slot->msg = *m ;
+    atomic_store( &slot->seq , pos + 1 ) ;
+
+    if ( atomic_load( &r->consumerIdle ) )
+    {
+        atomic_fetch_add( &r->dataWord , 1 ) ;
+        Futex_wake( (int *) &r->dataWord , 1 ) ;
+    }
+}
+
+/*--------------------------------------------------------------------
+   Consumer side: copy the next message out if there is one.
+   Returns 1 if a message was taken, 0 if the ring is empty.
+   Only one thread/process may ever consume from a given ring.
+----------------------------------------------------------------------*/
+int ringTryRecv( msgRing *r , msgBuf *m )
+{
+    ringSlot *slot = &r->slots[ r->head & RING_MASK ] ;
+
+    if ( atomic_load_explicit( &slot->seq , memory_order_acquire ) != r->head + 1 )
+        return 0 ;
+
+    *m = slot->msg ;
+    atomic_store( &slot->seq , r->head + r->nslots ) ;
+    r->head++ ;
+
+    if ( atomic_load( &r->producersWaiting ) > 0 )
+    {
+        atomic_fetch_add( &r->spaceWord , 1 ) ;
+        Futex_wake( (int *) &r->spaceWord , INT_MAX ) ;
+    }
+    return 1 ;
+}
+
+/*--------------------------------------------------------------------
+   Consumer side: block until a message is available and copy it out.
+----------------------------------------------------------------------*/
+void ringRecv( msgRing *r , msgBuf *m )
+{
+    while ( ! ringTryRecv( r , m ) )
+    {
+        ringSlot *slot = &r->slots[ r->head & RING_MASK ] ;
+
+        // Empty: announce we are going idle, then re-check before
+        // sleeping so a producer that just published is not missed
+        int w = atomic_load( &r->dataWord ) ;
+        atomic_store( &r->consumerIdle , 1 ) ;
+        if ( atomic_load( &slot->seq ) != r->head + 1 )
+            Futex_wait( (int *) &r->dataWord , w ) ;
+        atomic_store( &r->consumerIdle , 0 ) ;
+    }
+}
@@ -0,0 +1,59 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef RING_H
+#define RING_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+#include "message.h"
+
+// Everything laid out in shared memory keeps data written by
+// different processes on different cache lines of this size
+#define CACHE_LINE      64
+
+// Slot counts are powers of two, at least this many
+#define RING_MIN_SLOTS  1024
+
+// One message plus its sequence number. A slot at position 'pos' is
+// free for a producer when seq == pos and holds a message ready for
+// the consumer when seq == pos + 1
+typedef struct
+{
+    _Atomic unsigned  seq ;
+    msgBuf            msg ;
+} ringSlot ;
+
+// Multi-producer / single-consumer ring of msgBuf records that lives
+// in the shared segment. Nobody touches the kernel unless the consumer
+// is parked on an empty ring or a producer is parked on a full one.
+typedef struct
+{
+    // Written by producers
+    _Alignas(CACHE_LINE)
+    _Atomic unsigned  tail ;            // next position producers reserve
+    _Atomic int       producersWaiting ;// #producers parked on a full ring
+    _Atomic int       dataWord ;        // futex: bumped to wake the consumer
+
+    // Written by the consumer
+    _Alignas(CACHE_LINE)
+    unsigned          head ;            // next position the consumer reads
+    _Atomic int       consumerIdle ;    // consumer is (about to be) asleep
+    _Atomic int       spaceWord ;       // futex: bumped to wake producers
+
+    _Alignas(CACHE_LINE)
+    unsigned          nslots ;          // power of two, never changes
+    ringSlot          slots[] ;
+} msgRing ;
+
+unsigned ringSlotsFor( int nFactories ) ;
+size_t   ringBytes( unsigned nslots ) ;
+void ringInit( msgRing *r , unsigned nslots ) ;
+void ringSend( msgRing *r , const msgBuf *m ) ;
+void ringRecv( msgRing *r , msgBuf *m ) ;
+int  ringTryRecv( msgRing *r , msgBuf *m ) ;
+
+#endif
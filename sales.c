@@ -10,6 +10,7 @@
 #include <stdarg.h>
 #include <stdbool.h>
 #include <string.h>
+#include <limits.h>
 #include <errno.h>
 #include <time.h>
 #include <signal.h>
@@ -21,46 +22,113 @@
 #include <sys/msg.h>
 #include <sys/wait.h>
 #include <semaphore.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <spawn.h>
+#include <pthread.h>
 
 #include "wrappers.h"
 #include "message.h"
 #include "shmem.h"
+#include "claim.h"
+#include "transport.h"
+#include "factory.h"
+#include "supervisor.h"
+#include "logger.h"
+#include "trace.h"
+#include "simclock.h"
+#include "placement.h"
+#include "checkpoint.h"
+#include "net.h"
+#include "gateway.h"
+#include "workload.h"
 
-// Unique and fixed semaphores for consistent communication
-#define SEM_SHM_NAME          "/Team25_shm_mutex"
-#define SEM_LOG_NAME          "/Team25_log_mutex"
-#define SEM_DONE_NAME         "/Team25_done"
-#define SEM_PRINT_NAME        "/Team25_print"
+// Semaphores, named per run (runSemName) so runs never collide
+static char sem_shm_name[64], sem_log_name[64];
+
+// Supervisor and factory binaries, found next to our own
+static char supervisor_path[PATH_MAX], factory_path[PATH_MAX];
+
+// Stack for each supervisor / factory thread in --threads mode
+#define FACTORY_STACK_SIZE    (256 * 1024)
+
+// Most CPUs --pin-supervisor looks through
+#define CPU_LIST_MAX          1024
 
 // cleanup and sig handling defaults
 static int shmid = -1;
 static int msgid = -1;
+static int doorbell = -1;
 shData *p_shm;
-sem_t *sem_shm, *sem_log, *sem_done, *sem_print;
+sem_t *sem_shm, *sem_log;
 
-static pid_t children[MAXFACTORIES + 1];
+// Sized from N once the arguments are known
+static pid_t *children;
 static int num_children = 0;
 
+// --threads: supervisor and factories run as threads of Sales
+static bool use_threads = false;
+static pthread_t *threads;
+static pthread_attr_t thread_attr;
+static int num_threads = 0;
+static supervisorArgs sup_args;
+static factoryArgs *fac_args;
+static FILE *sup_log, *fac_log;
+static logger *fac_logger;      // shared by every factory thread, NULL in LOG_SYNC mode
+
+// How factory processes are started
+typedef enum {
+    LAUNCH_FORK = 0,    // Fork() + dup2 + execl per factory
+    LAUNCH_SPAWN,       // posix_spawn, the log redirection as a file action
+    LAUNCH_ZYGOTE       // one pre-initialized factory process forks the rest
+} launch_t;
+
+static const char *launch_names[] = { "fork", "spawn", "zygote" };
+static int launch_mode = LAUNCH_FORK;
+static int zygote_fd = -1;      // write end of the zygote's request pipe
+
+// --checkpoint / --resume: progress saved to a mapped file
+static checkpoint *ckpt;
+static int ckpt_order;          // size of the order being saved
+
+// --remote / --listen: factories on other hosts, served by a gateway
+static int num_remote = 0;
+static const char *listen_addr;
+static int accept_ms = 30000;
+static gateway gw;
+
+// --autoscale / --target-ms: factories join or retire mid-order so
+// the order is done by the target
+static int max_factories;       // room in the segment, 0 without --autoscale
+static long long target_ns;     // CLOCK_MONOTONIC the order should be done by
+static int order_slot;
+static int *capacities, *durations;     // drawn for every factory that may join
+static int scaled_in, scaled_out;
+
+extern char **environ;
+
 // Close and unlink semaphores, remove shared
 // memory, and destroy message queue
 static void clean_ipc(void) {
     // Close semaphores
     Sem_close(sem_shm);
     Sem_close(sem_log);
-    Sem_close(sem_done);
-    Sem_close(sem_print);
 
     // Unlink semaphores
-    Sem_unlink(SEM_SHM_NAME);
-    Sem_unlink(SEM_LOG_NAME);
-    Sem_unlink(SEM_DONE_NAME);
-    Sem_unlink(SEM_PRINT_NAME);
+    Sem_unlink(sem_shm_name);
+    Sem_unlink(sem_log_name);
 
-    // Detach shm
-    Shmdt(p_shm);
+    if (use_threads) {
+        // In-process shData
+        free(p_shm);
+    } else {
+        // Detach shm
+        Shmdt(p_shm);
 
-    // Destroy shm
-    shmctl(shmid, IPC_RMID, NULL);
+        // Destroy shm
+        shmctl(shmid, IPC_RMID, NULL);
+    }
 
     // Destroy message queue
     if (msgid >= 0) {
@@ -68,79 +136,73 @@ static void clean_ipc(void) {
         msgid = -1;
     }
 
+    if (doorbell >= 0) {
+        close(doorbell);
+        doorbell = -1;
+    }
+
+    if (listen_addr)
+        netUnlink(listen_addr);
+
 }
 
-// Kills all children
+// Kills all children, and the zygote's as well
 static void kill_children(void) {
     for (int i = 0; i < num_children; i++) {
         if (children[i] > 0) {
             kill(children[i], SIGKILL);
         }
     }
+    if (launch_mode == LAUNCH_ZYGOTE) {
+        for (int i = 1; i <= p_shm->nFactories; i++) {
+            if (shmStats(p_shm, i)->pid > 0)
+                kill(shmStats(p_shm, i)->pid, SIGKILL);
+        }
+    }
+}
+
+// Saves the order's progress. The signal handler saves too, so it
+// is kept out while we are halfway through a slot
+static void save_checkpoint(void) {
+    sigset_t sigs, old;
+    sigemptyset(&sigs);
+    sigaddset(&sigs, SIGINT);
+    sigaddset(&sigs, SIGTERM);
+    sigprocmask(SIG_BLOCK, &sigs, &old);
+    ckptSave(ckpt, p_shm, 1, ckpt_order);
+    sigprocmask(SIG_SETMASK, &old, NULL);
 }
 
-// Kill, cleanup, and exit
+// Kill, cleanup, and exit. With a checkpoint, everything the
+// factories finished is saved once they can finish no more
 static void sig_handler(int sig) {
     (void)sig;
     kill_children();
+    if (ckpt)
+        ckptSave(ckpt, p_shm, 1, ckpt_order);
     clean_ipc();
     _exit(0);
 }
 
-// Makes a key
-static key_t make_key(char token) {
-    key_t k = ftok("shmem.h", token);
-    if (k == (key_t)-1) {
-        perror("Failed to make key");
-        exit(1);
+// Finds the supervisor and factory binaries in the directory Sales
+// itself was run from, so a run can use any working directory (its
+// logs land there) without copies of the binaries
+static void find_binaries(void) {
+    char self[PATH_MAX];
+    ssize_t n = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (n <= 0) {
+        strcpy(supervisor_path, "./supervisor");
+        strcpy(factory_path, "./factory");
+        return;
     }
-    return k;
+    self[n] = '\0';
+    *strrchr(self, '/') = '\0';
+    snprintf(supervisor_path, sizeof(supervisor_path), "%s/supervisor", self);
+    snprintf(factory_path, sizeof(factory_path), "%s/factory", self);
 }
 
-int main(int argc, char **argv) {
-    // Wrong number of arguments
-    if (argc != 3) {
-        fprintf(stderr, "Usage: %s <num_factories> <order_size>\n", argv[0]);
-        return 1;
-    }
-
-    // Get num of factories and order size
-    int N = atoi(argv[1]);
-    int order = atoi(argv[2]);
-
-    // Invalid arguments
-    if (N <= 0 || N > MAXFACTORIES || order <= 0) {
-        fprintf(stderr, "Invalid arguments.\n");
-        return 1;    
-    }
-
-    // Create IPC objects
-    key_t shm_key = make_key('S');
-    key_t msg_key = make_key('Q');
-
-    // Get and attach shared memory
-    shmid = Shmget(shm_key, SHMEM_SIZE, IPC_CREAT | IPC_EXCL | S_IRUSR | S_IWUSR);
-    p_shm   = (shData*)Shmat(shmid, NULL, 0);
-
-    // Set the fields of the shared memory
-    p_shm->order_size = order;
-    p_shm->made = 0;
-    p_shm->remain = order;
-    p_shm->activeFactories = N;
-
-    // Get message queue
-    msgid = Msgget(msg_key, IPC_CREAT | IPC_EXCL | S_IRUSR | S_IWUSR);
-
-    // Create named semaphores
-    sem_shm = Sem_open(SEM_SHM_NAME,   O_CREAT | O_EXCL, S_IRUSR | S_IWUSR, 1);
-    sem_log = Sem_open(SEM_LOG_NAME,   O_CREAT | O_EXCL, S_IRUSR | S_IWUSR, 1);
-    sem_done = Sem_open(SEM_DONE_NAME,  O_CREAT | O_EXCL, S_IRUSR | S_IWUSR, 0);
-    sem_print = Sem_open(SEM_PRINT_NAME, O_CREAT | O_EXCL, S_IRUSR | S_IWUSR, 0);
-
-    // Seed random once (portable)
-    srand((unsigned)time(NULL));
-
-    // Launch supervisor (stdout -> supervisor.log)
+// Launch supervisor (stdout -> supervisor.log)
+static pid_t launch_supervisor(int N, key_t shm_key, key_t msg_key) {
     pid_t pid = Fork();
 
     // If supervisor, supervisor executes and
@@ -161,85 +223,1006 @@ int main(int argc, char **argv) {
         snprintf(msgkeybuf, sizeof(msgkeybuf), "%d", (int)msg_key);
 
         // Passes num of factories, shared memory and
-        // message queue keys, and sem names
-        execlp("./supervisor", "supervisor",
+        // message queue keys
+        execl(supervisor_path, "supervisor",
                nbuf, shmkeybuf, msgkeybuf,
-               SEM_DONE_NAME, SEM_PRINT_NAME,
                (char*)NULL);
         _exit(2);
     }
+    return pid;
+}
+
+// Launch a factory (stdout -> factory.log)
+static pid_t launch_factory(int i, int capacity, int duration, key_t shm_key, key_t msg_key) {
+    pid_t pid = Fork();
+
+    // If factory, factory executes and
+    // redirects stdout to factory.log
+    if (pid == 0) {
+        // Creates factory.log, write only, create+append
+        // to ensure they don't write over each other
+        int fd = open("factory.log", O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+        if (fd < 0) _exit(2);
+
+        // Redirect stdout to factory.log
+        dup2(fd, STDOUT_FILENO);
+        close(fd);
+
+        // Set argument buffers
+        char idbuf[16], capbuf[16], durbuf[16], shmkeybuf[32], msgkeybuf[32];
+        snprintf(idbuf, sizeof(idbuf), "%d", i);
+        snprintf(capbuf, sizeof(capbuf), "%d", capacity);
+        snprintf(durbuf, sizeof(durbuf), "%d", duration);
+        snprintf(shmkeybuf, sizeof(shmkeybuf), "%d", (int)shm_key);
+        snprintf(msgkeybuf, sizeof(msgkeybuf), "%d", (int)msg_key);
+
+        // Passes factory number, capacity, duration,
+        // shm and msgQ keys, and sem names
+        execl(factory_path, "factory",
+               idbuf, capbuf, durbuf,
+               shmkeybuf, msgkeybuf,
+               sem_shm_name, sem_log_name,
+               (char*)NULL);
+        _exit(2);
+    }
+    return pid;
+}
+
+// Launch a factory with posix_spawn (stdout -> factory.log). Nothing
+// runs in a copy of Sales between the fork and the exec, so the
+// library can use vfork-style spawning
+static pid_t spawn_factory(int i, int capacity, int duration, key_t shm_key, key_t msg_key) {
+    // Set argument buffers
+    char idbuf[16], capbuf[16], durbuf[16], shmkeybuf[32], msgkeybuf[32];
+    snprintf(idbuf, sizeof(idbuf), "%d", i);
+    snprintf(capbuf, sizeof(capbuf), "%d", capacity);
+    snprintf(durbuf, sizeof(durbuf), "%d", duration);
+    snprintf(shmkeybuf, sizeof(shmkeybuf), "%d", (int)shm_key);
+    snprintf(msgkeybuf, sizeof(msgkeybuf), "%d", (int)msg_key);
+    char *args[] = { "factory", idbuf, capbuf, durbuf, shmkeybuf, msgkeybuf,
+                     sem_shm_name, sem_log_name, NULL };
+
+    // Same redirection as launch_factory: factory.log, create+append
+    posix_spawn_file_actions_t fa;
+    posix_spawn_file_actions_init(&fa);
+    posix_spawn_file_actions_addopen(&fa, STDOUT_FILENO, "factory.log",
+                                     O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+
+    pid_t pid;
+    int rc = posix_spawn(&pid, factory_path, &fa, NULL, args, environ);
+    posix_spawn_file_actions_destroy(&fa);
+    if (rc != 0)
+        posix_error(rc, "posix_spawn failed");
+    return pid;
+}
+
+// Launch the zygote (stdout -> factory.log, stdin <- our request pipe)
+static pid_t launch_zygote(key_t shm_key, key_t msg_key) {
+    int fds[2];
+    if (pipe(fds) < 0) {
+        perror("pipe");
+        exit(2);
+    }
+    // Factories forked later must not hold the write end open
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+    pid_t pid = Fork();
+    if (pid == 0) {
+        int fd = open("factory.log", O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
+        if (fd < 0) _exit(2);
+
+        // Redirect stdout to factory.log, stdin from the pipe
+        dup2(fd, STDOUT_FILENO);
+        close(fd);
+        dup2(fds[0], STDIN_FILENO);
+        close(fds[0]);
+
+        char shmkeybuf[32], msgkeybuf[32];
+        snprintf(shmkeybuf, sizeof(shmkeybuf), "%d", (int)shm_key);
+        snprintf(msgkeybuf, sizeof(msgkeybuf), "%d", (int)msg_key);
+        execl(factory_path, "factory", "--zygote",
+               shmkeybuf, msgkeybuf,
+               sem_shm_name, sem_log_name,
+               (char*)NULL);
+        _exit(2);
+    }
+
+    close(fds[0]);
+    zygote_fd = fds[1];
+    return pid;
+}
+
+// Ask the zygote for factory # i
+static void zygote_factory(int i, int capacity, int duration) {
+    zygoteReq r = { i, capacity, duration };
+    if (write(zygote_fd, &r, sizeof(r)) != sizeof(r)) {
+        perror("zygote request");
+        exit(2);
+    }
+}
+
+// Start the supervisor as a thread sharing our shData and semaphores
+static void start_supervisor_thread(int N) {
+    sup_args = (supervisorArgs) {
+        .N = N, .shm = p_shm, .msgid = msgid,
+        .log = sup_log, .sigfd = -1
+    };
+    Pthread_create(&threads[num_threads++], &thread_attr, supervisorThread, &sup_args);
+}
+
+// Start factory # i as a thread sharing our shData and semaphores
+static void start_factory_thread(int i, int capacity, int duration) {
+    fac_args[i] = (factoryArgs) {
+        .id = i, .capacity = capacity, .duration = duration,
+        .shm = p_shm, .msgid = msgid,
+        .sem_shm = sem_shm, .sem_log = sem_log,
+        .log = fac_log, .lg = fac_logger
+    };
+    Pthread_create(&threads[num_threads++], &thread_attr, factoryThread, &fac_args[i]);
+}
+
+// Start factory # i however factories are started. One that joins
+// mid-order is never the zygote's: its pipe closed with the plant's
+// start, and a single late factory has no startup cost worth saving
+static void launch_one(int i, bool late, key_t shm_key, key_t msg_key) {
+    int capacity = capacities[i];
+    int duration = durations[i];
+
+    // Launch a factory. The zygote records its children's pids
+    // itself; ours are added to children and the supervisor
+    // watches them
+    if (use_threads) {
+        start_factory_thread(i, capacity, duration);
+    } else if (launch_mode == LAUNCH_ZYGOTE && !late) {
+        zygote_factory(i, capacity, duration);
+    } else {
+        pid_t pid = (launch_mode == LAUNCH_SPAWN) ? spawn_factory(i, capacity, duration, shm_key, msg_key)
+                                                  : launch_factory(i, capacity, duration, shm_key, msg_key);
+        children[num_children++] = pid;
+        shmStats(p_shm, i)->pid = pid;
+    }
+
+    // The plant's pids are posted all at once, after the launch loop
+    if (late && !use_threads) {
+        uint64_t one = 1;
+        atomic_fetch_add(&p_shm->pidsPosted, 1);
+        if (write(doorbell, &one, sizeof(one)) < 0)
+            perror("doorbell");
+    }
+}
+
+// --autoscale, once every --scale-ms: project when the order will be
+// done from the rate each factory has actually made parts at (what
+// its PRODUCTION reports carry, kept in its stats entry). Past the
+// target, add the next factory; comfortably ahead of it, retire the
+// slowest one if the rest would still finish with a fifth of the
+// time to spare. One change per step, and no factory is added while
+// the last one added has yet to make its first batch
+static void autoscale(key_t shm_key, key_t msg_key) {
+    orderSlot *o = &p_shm->orders[order_slot];
+    int joined = shmJoined(p_shm);
+    long long now = Clock_ns();
+    double rate = 0, slowest = 0;
+    int made = 0, working = 0, slow = 0;
+    bool measured = true, addedMeasured = true;
+
+    for (int i = 1; i <= joined; i++) {
+        factoryStats *st = shmStats(p_shm, i);
+        int parts = atomic_load(&st->parts);
+        made += parts;
+        if (atomic_load(&st->retire))
+            continue;
+        working++;
+        if (atomic_load(&st->iters) == 0) {
+            measured = false;
+            addedMeasured = addedMeasured && !st->joinedNs;
+            continue;
+        }
+
+        // Parts per ms since it joined
+        long long since = st->joinedNs ? st->joinedNs : p_shm->startNs;
+        double r = parts / ((now - since) / 1e6);
+        rate += r;
+        if (!slow || r < slowest) {
+            slow = i;
+            slowest = r;
+        }
+    }
+
+    // Nothing measured yet, or nothing left that more factories could take
+    int remaining = o->order_size - made;
+    if (rate <= 0 || remaining <= 0 || orderUnclaimed(p_shm, o) == 0)
+        return;
+
+    long long eta = now + (long long)(remaining / rate * 1e6);
+    if (eta > target_ns) {
+        if (joined >= max_factories || !addedMeasured)
+            return;
+
+        // Only while the supervisor still waits for factories
+        int i = joined + 1, j = joined;
+        shmStats(p_shm, i)->joinedNs = now;
+        if (!atomic_compare_exchange_strong(&p_shm->joined, &j, i)) {
+            shmStats(p_shm, i)->joinedNs = 0;
+            return;
+        }
+        launch_one(i, true, shm_key, msg_key);
+        scaled_in++;
+        printf("SALES: ETA %.0f ms is past the %.0f ms target: Factory # %2d joined, with Capacity= %3d and Duration= %4d\n",
+               (eta - p_shm->startNs) / 1e6, (target_ns - p_shm->startNs) / 1e6, i, capacities[i], durations[i]);
+        fflush(stdout);
+    } else if (measured && working > 1 && rate > slowest
+               && remaining / (rate - slowest) * 1e6 <= 0.8 * (target_ns - now)) {
+        atomic_store(&shmStats(p_shm, slow)->retire, 1);
+        scaled_out++;
+        printf("SALES: ETA %.0f ms is well within the %.0f ms target: Factory # %2d was asked to retire\n",
+               (eta - p_shm->startNs) / 1e6, (target_ns - p_shm->startNs) / 1e6, slow);
+        fflush(stdout);
+    }
+}
+
+// Milliseconds since Sales started, the clock order deadlines use
+static struct timespec sales_start;
+
+static double now_ms(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (t.tv_sec - sales_start.tv_sec) * 1e3 + (t.tv_nsec - sales_start.tv_nsec) / 1e6;
+}
+
+// Stream mode: read the next valid order from 'in' as
+// "<size> [deadline_ms]". Returns false at end of input
+static bool next_order(FILE *in, int *size, int *deadline) {
+    char line[128];
+
+    while (fgets(line, sizeof(line), in)) {
+        char *p = line, *end, *end2;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\0')
+            continue;
+
+        long sz = strtol(p, &end, 10);
+        long dl = strtol(end, &end2, 10);
+        if (end == p || sz <= 0 || sz > INT_MAX || dl < 0 || dl > INT_MAX / 2) {
+            fprintf(stderr, "SALES: Ignoring bad order '%s'\n", strtok(p, "\n"));
+            continue;
+        }
+
+        // Deadlines are relative to when the order arrives
+        *size = (int)sz;
+        *deadline = (end2 == end) ? NO_DEADLINE : (int)(now_ms() + dl);
+        return true;
+    }
+    return false;
+}
+
+// Stream mode: feed every order in 'in' (one per line, blank lines
+// and '#' comments ignored) through the pool, keeping up to
+// 'max_open' of them in flight at once
+static void run_stream(FILE *in, int max_open) {
+    double posted[MAXORDERS];
+    int k = 0, open = 0, reaped = 0;
+    bool eof = false;
 
-    // Adds pid of supervisor
-    children[num_children++] = pid;
+    while (!eof || open > 0) {
+        // Top up the order table
+        int size, deadline;
+        while (!eof && open < max_open) {
+            if (!next_order(in, &size, &deadline)) {
+                eof = true;
+                break;
+            }
+            int slot = openOrder(p_shm, ++k, size, deadline);
+            posted[slot] = now_ms();
+            open++;
+            printf("SALES: Order # %d of %d parts requested\n", k, size);
+            fflush(stdout);
 
-    printf("SALES: Will Request an Order of Size = %d parts\n", order);
+            // Wake every parked factory
+            atomic_fetch_add(&p_shm->workWord, 1);
+            Futex_wake((int*)&p_shm->workWord, INT_MAX);
+        }
+        if (open == 0)
+            break;
+
+        // Block until the supervisor finishes at least one more order
+        int done;
+        while ((done = atomic_load(&p_shm->ordersDone)) == reaped) {
+            Futex_wait((int*)&p_shm->ordersDone, done);
+        }
+
+        // Free every finished slot
+        for (int i = 0; i < MAXORDERS; i++) {
+            orderSlot *o = &p_shm->orders[i];
+            if (atomic_load(&o->state) != SLOT_DONE)
+                continue;
+            printf("SALES: Order # %d completed in %.1f ms\n", o->orderID, now_ms() - posted[i]);
+            fflush(stdout);
+            atomic_store(&o->state, SLOT_FREE);
+            open--;
+            reaped++;
+        }
+    }
+
+    // No more orders: let the factories wind down
+    atomic_store(&p_shm->shutdown, 1);
+    atomic_fetch_add(&p_shm->workWord, 1);
+    Futex_wake((int*)&p_shm->workWord, INT_MAX);
+}
+
+// Prints usage
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [--threads] [--claim atomic|sem|steal] [--transport msgq|ring] [--batch fixed|guided|rate]\n"
+                    "          [--stats-shm] [--coalesce K] [--flush-ms T] [--log sync|async|async-tagged|binary]\n"
+                    "          [--sim | --time-scale F] [--launch fork|spawn|zygote]\n"
+                    "          [--pin-factories] [--pin-supervisor CPU] [--shm-numa NODE|interleave]\n"
+                    "          [--run-id ID] [--report-delay MS] [--checkpoint FILE [--checkpoint-ms MS]]\n"
+                    "          [--remote R --listen unix:PATH|[HOST:]PORT [--accept-ms MS]]\n"
+                    "          [--workload FILE] [--seed S]\n"
+                    "          [--autoscale MAX --target-ms T [--scale-ms MS]]\n"
+                    "          <num_factories> <order_size>\n"
+                    "       %s [options] --resume FILE\n"
+                    "       %s [options] --stream <orders_file|-> [--max-open K] [--order-policy fifo|edf] <num_factories>\n"
+                    "A --workload spec that gives factories (and order) stands in for the arguments.\n",
+            prog, prog, prog);
+}
+
+int main(int argc, char **argv) {
+    clock_gettime(CLOCK_MONOTONIC, &sales_start);
+
+    // Optional settings
+    int claimMode = CLAIM_ATOMIC;
+    int transport = TRANSPORT_MSGQ;
+    const char *stream_path = NULL;
+    int max_open = 1;
+    int orderPolicy = ORDER_FIFO;
+    int batchPolicy = BATCH_FIXED;
+    bool statsInShm = false;
+    int msgCoalesce = 1;
+    int flushMs = 0;
+    int logMode = LOG_SYNC;
+    bool simulated = false;
+    double timeScale = 1.0;
+    bool pinFactories = false;
+    int supervisorCpu = -1;
+    int shmNuma = NUMA_NONE;
+    int run_id = getpid();
+    int report_delay = -1;      // ms before the final report, -1 for the default
+    const char *checkpoint_path = NULL;
+    const char *resume_path = NULL;
+    int checkpoint_ms = 100;
+    const char *workload_path = NULL;
+    bool seed_given = false;
+    uint64_t seed = 0;
+    int target_ms = 0;
+    int scale_ms = 100;
+
+    static const struct option longopts[] = {
+        { "claim",     required_argument, NULL, 'c' },
+        { "transport", required_argument, NULL, 't' },
+        { "threads",   no_argument,       NULL, 'T' },
+        { "stream",    required_argument, NULL, 's' },
+        { "max-open",     required_argument, NULL, 'k' },
+        { "order-policy", required_argument, NULL, 'p' },
+        { "batch",        required_argument, NULL, 'b' },
+        { "stats-shm",    no_argument,       NULL, 'S' },
+        { "coalesce",     required_argument, NULL, 'C' },
+        { "flush-ms",     required_argument, NULL, 'F' },
+        { "log",          required_argument, NULL, 'L' },
+        { "sim",          no_argument,       NULL, 'V' },
+        { "time-scale",   required_argument, NULL, 'X' },
+        { "launch",       required_argument, NULL, 'l' },
+        { "pin-factories",  no_argument,       NULL, 'P' },
+        { "pin-supervisor", required_argument, NULL, 'U' },
+        { "shm-numa",       required_argument, NULL, 'N' },
+        { "run-id",         required_argument, NULL, 'R' },
+        { "report-delay",   required_argument, NULL, 'D' },
+        { "checkpoint",     required_argument, NULL, 'K' },
+        { "checkpoint-ms",  required_argument, NULL, 'I' },
+        { "resume",         required_argument, NULL, 'E' },
+        { "remote",         required_argument, NULL, 'M' },
+        { "listen",         required_argument, NULL, 'A' },
+        { "accept-ms",      required_argument, NULL, 'Q' },
+        { "workload",       required_argument, NULL, 'W' },
+        { "seed",           required_argument, NULL, 'Y' },
+        { "autoscale",      required_argument, NULL, 'G' },
+        { "target-ms",      required_argument, NULL, 'J' },
+        { "scale-ms",       required_argument, NULL, 'H' },
+        { NULL,        0,                 NULL,  0  }
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "c:t:Ts:k:p:b:SC:F:L:VX:l:PU:N:R:D:K:I:E:M:A:Q:W:Y:G:J:H:", longopts, NULL)) != -1) {
+        switch (opt) {
+        case 'c':
+            claimMode = claimModeFromName(optarg);
+            if (claimMode < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 't':
+            transport = transportFromName(optarg);
+            if (transport < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'T':
+            use_threads = true;
+            break;
+        case 's':
+            stream_path = optarg;
+            break;
+        case 'k':
+            max_open = atoi(optarg);
+            if (max_open < 1 || max_open > MAXORDERS) {
+                fprintf(stderr, "--max-open must be between 1 and %d\n", MAXORDERS);
+                return 1;
+            }
+            break;
+        case 'S':
+            statsInShm = true;
+            break;
+        case 'V':
+            simulated = true;
+            break;
+        case 'P':
+            pinFactories = true;
+            break;
+        case 'U': {
+            // Only a CPU we are allowed to run on
+            int cpus[CPU_LIST_MAX], n = placementCpus(cpus, CPU_LIST_MAX);
+            supervisorCpu = atoi(optarg);
+            bool ok = false;
+            for (int c = 0; c < n; c++)
+                ok = ok || cpus[c] == supervisorCpu;
+            if (!ok) {
+                fprintf(stderr, "--pin-supervisor: CPU %s is not available to us\n", optarg);
+                return 1;
+            }
+            break;
+        }
+        case 'N':
+            shmNuma = strcmp(optarg, "interleave") == 0 ? NUMA_INTERLEAVE : atoi(optarg);
+            if (shmNuma != NUMA_INTERLEAVE && (shmNuma < 0 || shmNuma >= numaNodes())) {
+                fprintf(stderr, "--shm-numa must be a node from 0 to %d, or interleave\n", numaNodes() - 1);
+                return 1;
+            }
+            break;
+        case 'R':
+            run_id = atoi(optarg);
+            if (run_id < 1 || run_id > RUN_ID_MAX) {
+                fprintf(stderr, "--run-id must be between 1 and %d\n", RUN_ID_MAX);
+                return 1;
+            }
+            break;
+        case 'D':
+            report_delay = atoi(optarg);
+            if (report_delay < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'K':
+            checkpoint_path = optarg;
+            break;
+        case 'M':
+            num_remote = atoi(optarg);
+            if (num_remote < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'A':
+            listen_addr = optarg;
+            break;
+        case 'Q':
+            accept_ms = atoi(optarg);
+            if (accept_ms < 1) {
+                fprintf(stderr, "--accept-ms must be at least 1\n");
+                return 1;
+            }
+            break;
+        case 'W':
+            workload_path = optarg;
+            break;
+        case 'G':
+            max_factories = atoi(optarg);
+            if (max_factories < 1) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'J':
+            target_ms = atoi(optarg);
+            if (target_ms < 1) {
+                fprintf(stderr, "--target-ms must be at least 1\n");
+                return 1;
+            }
+            break;
+        case 'H':
+            scale_ms = atoi(optarg);
+            if (scale_ms < 1) {
+                fprintf(stderr, "--scale-ms must be at least 1\n");
+                return 1;
+            }
+            break;
+        case 'Y': {
+            char *end;
+            seed = strtoull(optarg, &end, 10);
+            if (end == optarg || *end != '\0') {
+                fprintf(stderr, "--seed must be a non-negative integer\n");
+                return 1;
+            }
+            seed_given = true;
+            break;
+        }
+        case 'E':
+            resume_path = optarg;
+            break;
+        case 'I':
+            checkpoint_ms = atoi(optarg);
+            if (checkpoint_ms < 1) {
+                fprintf(stderr, "--checkpoint-ms must be at least 1\n");
+                return 1;
+            }
+            break;
+        case 'l':
+            launch_mode = -1;
+            for (int m = LAUNCH_FORK; m <= LAUNCH_ZYGOTE; m++)
+                if (strcmp(optarg, launch_names[m]) == 0)
+                    launch_mode = m;
+            if (launch_mode < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'X':
+            timeScale = atof(optarg);
+            if (timeScale < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'C':
+            msgCoalesce = atoi(optarg);
+            if (msgCoalesce < 1 || msgCoalesce > MSG_BATCH_MAX) {
+                fprintf(stderr, "--coalesce must be between 1 and %d\n", MSG_BATCH_MAX);
+                return 1;
+            }
+            break;
+        case 'L':
+            logMode = logModeFromName(optarg);
+            if (logMode < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'F':
+            flushMs = atoi(optarg);
+            if (flushMs < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'b':
+            batchPolicy = batchPolicyFromName(optarg);
+            if (batchPolicy < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'p':
+            orderPolicy = orderPolicyFromName(optarg);
+            if (orderPolicy < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // What the factories get to do: the spec if there is one, else
+    // the historical ranges. Either way from a seed that is printed,
+    // so any run can be drawn again with --seed
+    workload wl;
+    workloadDefault(&wl, (uint64_t)time(NULL) ^ ((uint64_t)getpid() << 32));
+    if (workload_path && workloadLoad(&wl, workload_path) < 0)
+        return 1;
+    if (seed_given)
+        wl.seed = seed;
+
+    // Wrong number of arguments; a resumed run takes its own, and
+    // a spec may give them instead
+    int nargs = argc - optind;
+    bool from_spec = nargs == 0 && !resume_path && wl.factories > 0 && (stream_path || wl.order > 0);
+    if (nargs != (resume_path ? 0 : stream_path ? 1 : 2) && !from_spec) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // A checkpoint covers one order, and a resumed run goes on
+    // saving into the file it resumed from
+    if ((checkpoint_path || resume_path) && stream_path) {
+        fprintf(stderr, "--checkpoint and --resume cannot be combined with --stream\n");
+        return 1;
+    }
+    if (checkpoint_path && resume_path) {
+        fprintf(stderr, "--resume keeps saving to its own file; drop --checkpoint\n");
+        return 1;
+    }
+
+    // Remote factories work one order on the real clock, and are
+    // not part of what a checkpoint can restart
+    if ((num_remote > 0) != (listen_addr != NULL)) {
+        fprintf(stderr, "--remote and --listen go together\n");
+        return 1;
+    }
+    if (num_remote > 0 && (stream_path || simulated || checkpoint_path || resume_path)) {
+        fprintf(stderr, "--remote cannot be combined with --stream, --sim, --checkpoint or --resume\n");
+        return 1;
+    }
+
+    // Autoscaling steers one order of local factories toward a target
+    // on the real clock; a checkpoint could not restart the factories
+    // that joined
+    if ((max_factories > 0) != (target_ms > 0)) {
+        fprintf(stderr, "--autoscale and --target-ms go together\n");
+        return 1;
+    }
+    if (max_factories > 0 && (stream_path || simulated || checkpoint_path || resume_path || num_remote > 0)) {
+        fprintf(stderr, "--autoscale cannot be combined with --stream, --sim, --checkpoint, --resume or --remote\n");
+        return 1;
+    }
+
+    // A stream's orders arrive on Sales' real clock, which a virtual
+    // schedule has no way to line up with
+    if (simulated && stream_path) {
+        fprintf(stderr, "--sim cannot be combined with --stream\n");
+        return 1;
+    }
+
+    // Get num of factories and order size (orders come later in
+    // stream mode, and from the checkpoint when resuming)
+    int N, order, resumed_made = 0;
+    ckptSlot *resumed = NULL;
+    if (resume_path) {
+        ckpt = ckptOpen(resume_path);
+        if (!ckpt)
+            return 1;
+        resumed = ckptLatest(ckpt);
+        if (!resumed) {
+            fprintf(stderr, "%s: no checkpoint was ever saved\n", resume_path);
+            return 1;
+        }
+        N = ckpt->h->nFactories;
+        if (wl.factories > 0 && wl.factories != N) {
+            fprintf(stderr, "%s has %d factories, %s wants %d\n", resume_path, N, workload_path, wl.factories);
+            return 1;
+        }
+        order = resumed->orderSize;
+        resumed_made = resumed->made;
+        if (resumed_made >= order) {
+            printf("SALES: Order of %d parts in %s is already complete\n", order, resume_path);
+            return 0;
+        }
+    } else {
+        N = from_spec ? wl.factories : atoi(argv[optind]);
+        order = stream_path ? 1 : from_spec ? wl.order : atoi(argv[optind + 1]);
+    }
+
+    FILE *orders = NULL;
+    if (stream_path) {
+        orders = strcmp(stream_path, "-") == 0 ? stdin : fopen(stream_path, "r");
+        if (!orders) {
+            perror(stream_path);
+            return 1;
+        }
+    }
+
+    // Invalid arguments
+    if (N <= 0 || order <= 0) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return 1;    
+    }
+
+    // With --autoscale, factories N+1 .. max_factories may join later
+    if (max_factories > 0 && max_factories < N) {
+        fprintf(stderr, "--autoscale must allow at least the %d factories we start with\n", N);
+        return 1;
+    }
+    int NL = max_factories > 0 ? max_factories : N;
+
+    // Draw every factory's capacity and duration, before there is
+    // anything to undo if the spec's table does not fit
+    capacities = calloc(NL + 1, sizeof(int));
+    durations  = calloc(NL + 1, sizeof(int));
+    if (!capacities || !durations) {
+        perror("calloc");
+        return 2;
+    }
+    if (workloadDraw(&wl, NL, capacities, durations) < 0)
+        return 1;
+    workloadFree(&wl);
+
+    // Remote factories get the IDs after our own N. Listen before
+    // creating anything, so a bad address costs nothing to undo
+    int NT = N + num_remote, NMAX = NL + num_remote;
+    if (listen_addr && (gw.listenFd = netListen(listen_addr)) < 0)
+        return 1;
+
+    // One slot per child: the supervisor plus every local factory
+    children = calloc(NL + 1, sizeof(pid_t));
+    threads  = calloc(NL + 1, sizeof(pthread_t));
+    fac_args = calloc(NL + 1, sizeof(factoryArgs));
+    if (!children || !threads || !fac_args) {
+        perror("calloc");
+        return 2;
+    }
+
+    // Thousands of factory threads need far less than the default
+    // 8MB of stack each
+    pthread_attr_init(&thread_attr);
+    pthread_attr_setstacksize(&thread_attr, FACTORY_STACK_SIZE);
+
+    // Create IPC objects, all named after this run
+    key_t shm_key = shmemKey(run_id, 'S');
+    key_t msg_key = shmemKey(run_id, 'Q');
+    runSemName(sem_shm_name, sizeof(sem_shm_name), run_id, "shm_mutex");
+    runSemName(sem_log_name, sizeof(sem_log_name), run_id, "log_mutex");
+    find_binaries();
+
+    // Get and attach shared memory, or keep shData in-process
+    // when everybody is a thread of ours. Either way it is whole
+    // pages, so it can be given a NUMA policy
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t shm_bytes = (shmemSize(NMAX) + page - 1) / page * page;
+    if (use_threads) {
+        p_shm = (shData*)aligned_alloc(page, shm_bytes);
+        if (!p_shm) {
+            perror("calloc");
+            return 2;
+        }
+    } else {
+        shmid = Shmget(shm_key, shmemSize(NMAX), IPC_CREAT | IPC_EXCL | S_IRUSR | S_IWUSR);
+        p_shm   = (shData*)Shmat(shmid, NULL, 0);
+    }
+
+    // Place the pages before shmemInit first touches them
+    if (shmNuma != NUMA_NONE && numaBind(p_shm, shm_bytes, shmNuma) < 0) {
+        perror("SALES: mbind, leaving the segment to first touch");
+        shmNuma = NUMA_NONE;
+    }
+
+    // Set the fields of the shared memory. In stream mode there
+    // is nothing to make until the first order is posted
+    shmemInit(p_shm, NMAX);
+    p_shm->joined = NT;
+    p_shm->pinFactories = pinFactories;
+    p_shm->supervisorCpu = supervisorCpu;
+    p_shm->shmNuma = shmNuma;
+    p_shm->streaming = (stream_path != NULL);
+    p_shm->activeFactories = NT;
+    p_shm->claimMode = claimMode;
+    p_shm->transport = transport;
+    p_shm->orderPolicy = orderPolicy;
+    p_shm->batchPolicy = batchPolicy;
+    p_shm->statsInShm = statsInShm;
+    p_shm->msgCoalesce = msgCoalesce;
+    p_shm->flushMs = flushMs;
+    p_shm->logMode = logMode;
+    p_shm->simulated = simulated;
+    // Virtual time is never scaled
+    p_shm->timeScale = simulated ? 1.0 : timeScale;
+    if (simulated)
+        simStart(p_shm);
+    if (resumed) {
+        // Pick up where the last run stopped: every factory's totals,
+        // and an order of which only the rest is left to make
+        p_shm->resumed = 1;
+        for (int i = 1; i <= N; i++) {
+            factoryStats *st = shmStats(p_shm, i);
+            atomic_store(&st->parts, resumed->fac[i].parts);
+            atomic_store(&st->iters, resumed->fac[i].iters);
+            atomic_store(&st->busyMs, resumed->fac[i].busyMs);
+            st->baseParts = resumed->fac[i].parts;
+            st->baseIters = resumed->fac[i].iters;
+            st->baseBusyMs = resumed->fac[i].busyMs;
+        }
+        resumeOrder(p_shm, 1, order, NO_DEADLINE, resumed_made);
+    } else if (!stream_path) {
+        order_slot = openOrder(p_shm, 1, order, NO_DEADLINE);
+    }
+
+    // Save once up front, so the file can be resumed from right away
+    if (checkpoint_path && !(ckpt = ckptCreate(checkpoint_path, N)))
+        return 1;
+    if (ckpt) {
+        ckpt_order = order;
+        ckptSave(ckpt, p_shm, 1, order);
+    }
+
+    // Get message queue
+    msgid = Msgget(msg_key, IPC_CREAT | IPC_EXCL | S_IRUSR | S_IWUSR);
+
+    // Doorbell for the supervisor's event loop. Not close-on-exec:
+    // every child inherits it under the same number
+    doorbell = Eventfd(0, EFD_NONBLOCK);
+    p_shm->doorbellFd = doorbell;
+
+    // Create named semaphores
+    sem_shm = Sem_open(sem_shm_name, O_CREAT | O_EXCL, S_IRUSR | S_IWUSR, 1);
+    sem_log = Sem_open(sem_log_name, O_CREAT | O_EXCL, S_IRUSR | S_IWUSR, 1);
+
+    // In thread mode both logs are opened once, here
+    if (use_threads) {
+        sup_log = fopen("supervisor.log", "w");
+        fac_log = fopen("factory.log", "a");
+        if (!sup_log || !fac_log) {
+            perror("fopen");
+            return 2;
+        }
+    }
+
+    // Binary traces start from a fresh header, before anyone appends
+    if (logMode == LOG_BINARY) {
+        long long origin = Clock_ns();
+        traceCreate(FACTORY_TRACE, origin);
+        traceCreate(SUPERVISOR_TRACE, origin);
+    }
+
+    // Launch supervisor
+    if (use_threads) {
+        start_supervisor_thread(NT);
+    } else {
+        // Adds pid of supervisor
+        children[num_children++] = launch_supervisor(NT, shm_key, msg_key);
+
+        // The zygote gets its setup done while we draw the factories
+        if (launch_mode == LAUNCH_ZYGOTE)
+            children[num_children++] = launch_zygote(shm_key, msg_key);
+    }
+
+    if (stream_path)
+        printf("SALES: Will Serve a Stream of Orders from %s\n", stream_path);
+    else if (resumed)
+        printf("SALES: Will Resume an Order of Size = %d parts, %d of them made before the restart\n",
+               order, resumed_made);
+    else
+        printf("SALES: Will Request an Order of Size = %d parts\n", order);
     printf("Creating %d Factory(ies)\n", N);
+    printf("SALES: Run ID = %d\n", run_id);
+    printf("SALES: Workload seed = %llu%s%s\n", (unsigned long long)wl.seed,
+           workload_path ? " from " : "", workload_path ? workload_path : "");
+
+    // Every factory's capacity and duration is known up front, so
+    // the plant's total rate is too before the first claim. It stays
+    // the starting plant's under --autoscale; batch shares are capped
+    // at capacity anyway
+    for (int i = 1; i <= N; i++)
+        p_shm->totalRate += (double)capacities[i] / durations[i];
+    p_shm->startNs = Clock_ns();
+    if (target_ms > 0)
+        target_ns = p_shm->startNs + target_ms * 1000000LL;
+
+    // In thread mode all factories share one async logger
+    if (use_threads && (logMode == LOG_ASYNC || logMode == LOG_ASYNC_TAGGED))
+        fac_logger = logOpen(fac_log, logMode, &p_shm->logSeq, p_shm->startNs);
 
     // Launch N factories
+    long long launchNs = Clock_ns();
     for (int i = 1; i <= N; i++) {
-        // Capacity is a random integer between 10 and 50
-        int capacity = (int)(rand()%41) + 10;
-        // Duration is a random integer between 500 and 1200
-        int duration = (int)(rand()%701) + 500;
-
-        // Launch a factory
-        pid = Fork();
-        // If factory, factory executes and
-        // redirects stdout to factory.log
-        if (pid == 0) {
-            // Creates factory.log, write only, create+append
-            // to ensure they don't write over each other
-            int fd = open("factory.log", O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR);
-            if (fd < 0) _exit(2);
-
-            // Redirect stdout to factory.log
-            dup2(fd, STDOUT_FILENO);
-            close(fd);
-
-            // Set argument buffers
-            char idbuf[16], capbuf[16], durbuf[16], shmkeybuf[32], msgkeybuf[32];
-            snprintf(idbuf, sizeof(idbuf), "%d", i);
-            snprintf(capbuf, sizeof(capbuf), "%d", capacity);
-            snprintf(durbuf, sizeof(durbuf), "%d", duration);
-            snprintf(shmkeybuf, sizeof(shmkeybuf), "%d", (int)shm_key);
-            snprintf(msgkeybuf, sizeof(msgkeybuf), "%d", (int)msg_key);
-        
-            // Passes factory number, capacity, duration,
-            // shm and msgQ keys, and sem names
-            execlp("./factory", "factory",
-                   idbuf, capbuf, durbuf,
-                   shmkeybuf, msgkeybuf,
-                   SEM_SHM_NAME, SEM_LOG_NAME,
-                   (char*)NULL);
-            _exit(2);
-        }
-
-        // Add each factory's pid
-        children[num_children++] = pid;
-
-        printf("SALES: Factory # %2d was created, with Capacity= %3d and Duration= %4d\n", i, capacity, duration);
+        launch_one(i, false, shm_key, msg_key);
+        printf("SALES: Factory # %2d was created, with Capacity= %3d and Duration= %4d\n",
+               i, capacities[i], durations[i]);
         fflush(stdout);
     }
 
+    long long launchedNs = Clock_ns();
+
+    // Tell the supervisor there are factory pids to watch; the
+    // zygote does that once we close its pipe
+    if (launch_mode == LAUNCH_ZYGOTE && zygote_fd >= 0) {
+        close(zygote_fd);
+        zygote_fd = -1;
+    } else if (!use_threads) {
+        uint64_t one = 1;
+        atomic_fetch_add(&p_shm->pidsPosted, 1);
+        if (write(doorbell, &one, sizeof(one)) < 0)
+            perror("doorbell");
+    }
+
     // Handle SIGINT and SIGTERM
     sigactionWrapper(SIGINT,  sig_handler);
     sigactionWrapper(SIGTERM, sig_handler);
 
-    // Wait for supervisor
-    Sem_wait(sem_done);
+    // Let the remote factories in; nothing is forked after this
+    if (num_remote > 0) {
+        gw = (gateway) {
+            .shm = p_shm, .msgid = msgid, .sem_shm = sem_shm,
+            .listenFd = gw.listenFd, .firstID = N + 1, .count = num_remote,
+            .acceptMs = accept_ms
+        };
+        printf("SALES: Waiting for %d Remote Factory(ies) on %s\n", num_remote, listen_addr);
+        fflush(stdout);
+        gatewayStart(&gw);
+    }
+
+    // Stream mode: feed orders until the input runs out
+    if (orders) {
+        run_stream(orders, max_open);
+        if (orders != stdin)
+            fclose(orders);
+    }
+
+    // Wait for supervisor, saving the order's progress meanwhile
+    if (ckpt) {
+        while (!atomic_load(&p_shm->supDone)) {
+            save_checkpoint();
+            Futex_waitFor((int*)&p_shm->supDone, 0, checkpoint_ms * 1000000LL);
+        }
+        save_checkpoint();
+    } else if (max_factories > 0) {
+        while (!atomic_load(&p_shm->supDone)) {
+            autoscale(shm_key, msg_key);
+            Futex_waitFor((int*)&p_shm->supDone, 0, scale_ms * 1000000LL);
+        }
+    } else {
+        flagWait(&p_shm->supDone);
+    }
     puts("SALES: Supervisor says all Factories have completed their mission");
+    if (num_remote > 0)
+        gatewayStop(&gw);
+    if (max_factories > 0)
+        printf("SALES: Autoscaling added %d and retired %d factories, for a target of %d ms\n",
+               scaled_in, scaled_out, target_ms);
+    free(capacities);
+    free(durations);
+
+    // Startup latency: from the first launch until the last factory
+    // was actually running
+    long long runningNs = launchNs;
+    for (int i = 1; i <= N; i++) {
+        long long t = atomic_load(&shmStats(p_shm, i)->startedNs);
+        if (t > runningNs)
+            runningNs = t;
+    }
+    printf("SALES: Launched %d factories by %s in %.1f ms; all were running after %.1f ms\n",
+           N, use_threads ? "threads" : launch_names[launch_mode],
+           (launchedNs - launchNs) / 1e6, (runningNs - launchNs) / 1e6);
 
-    // Sleep for 2 seconds
-    sleep(2);
+    // Pause before the report: --report-delay if given, else 2
+    // seconds scaled like every other sleep; simulated runs have
+    // nothing to wait for
+    double delay_ms = report_delay >= 0 ? report_delay : (simulated ? 0 : 2000 * timeScale);
+    if (delay_ms > 0)
+        Usleep((useconds_t)(delay_ms * 1000));
     puts("SALES: Permission granted to print final report");
-    Sem_post(sem_print);
+    flagRaise(&p_shm->printOK);
 
     // Reap
     for (int i = 0; i < num_children; i++) {
         waitpid(children[i], NULL, 0);
     }
+    for (int i = 0; i < num_threads; i++) {
+        Pthread_join(threads[i], NULL);
+    }
+    if (use_threads) {
+        if (fac_logger)
+            logClose(fac_logger);
+        fclose(sup_log);
+        fclose(fac_log);
+    }
 
     // Cleanup IPCs
+    if (ckpt) {
+        ckptClose(ckpt);
+        ckpt = NULL;
+    }
     clean_ipc();
     puts("SALES: Cleaning up after the Supervisor Factory Process");
     exit(0);
@@ -0,0 +1,276 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include "wrappers.h"
+#include "shmem.h"
+
+// Keep every region of the segment on its own cache line
+#define SHM_ALIGN( x )  ( ( (x) + CACHE_LINE - 1 ) & ~(size_t) ( CACHE_LINE - 1 ) )
+
+/*--------------------------------------------------------------------
+   Bytes needed for a segment serving 'nFactories' factories:
+   the shData header, the message ring, then one factoryStats per
+   factory (plus an unused entry 0 so factory IDs index it directly),
+   then one procInstr for the supervisor and each factory, then one
+   reservation per factory (entry 0 unused again)
+----------------------------------------------------------------------*/
+static size_t statsOffsetFor( int nFactories )
+{
+    return SHM_ALIGN( SHM_ALIGN( sizeof( shData ) ) + ringBytes( ringSlotsFor( nFactories ) ) ) ;
+}
+
+static size_t instrOffsetFor( int nFactories )
+{
+    return SHM_ALIGN( statsOffsetFor( nFactories ) + ( nFactories + 1 ) * sizeof( factoryStats ) ) ;
+}
+
+static size_t resvOffsetFor( int nFactories )
+{
+    return SHM_ALIGN( instrOffsetFor( nFactories ) + ( nFactories + 1 ) * sizeof( procInstr ) ) ;
+}
+
+size_t shmemSize( int nFactories )
+{
+    return resvOffsetFor( nFactories ) + ( nFactories + 1 ) * sizeof( reservation ) ;
+}
+
+/*--------------------------------------------------------------------
+   Zero the segment and lay out its variable-size regions.
+   Sales calls this once, before any factory or supervisor starts.
+----------------------------------------------------------------------*/
+void shmemInit( shData *shm , int nFactories )
+{
+    memset( shm , 0 , shmemSize( nFactories ) ) ;
+    shm->magic = SHM_MAGIC ;
+    shm->version = SHM_VERSION ;
+    shm->size = shmemSize( nFactories ) ;
+    shm->nFactories = nFactories ;
+    shm->joined = nFactories ;
+    shm->ringOffset = SHM_ALIGN( sizeof( shData ) ) ;
+    shm->statsOffset = statsOffsetFor( nFactories ) ;
+    shm->instrOffset = instrOffsetFor( nFactories ) ;
+    shm->resvOffset = resvOffsetFor( nFactories ) ;
+    shm->doorbellFd = -1 ;
+    shm->supervisorCpu = -1 ;
+    shm->shmNuma = NUMA_NONE ;
+    for ( int i = 0 ; i <= nFactories ; i++ )
+        shmStats( shm , i )->cpu = -1 ;
+    ringInit( shmRing( shm ) , ringSlotsFor( nFactories ) ) ;
+}
+
+/*--------------------------------------------------------------------
+   Refuse to run against a segment laid out by a different build
+----------------------------------------------------------------------*/
+void shmemCheck( shData *shm )
+{
+    if ( shm->magic != SHM_MAGIC || shm->version != SHM_VERSION )
+    {
+        fprintf( stderr , "Shared memory layout mismatch: magic %#x version %u, expected %#x version %u\n" ,
+                 shm->magic , shm->version , SHM_MAGIC , SHM_VERSION ) ;
+        exit( -1 ) ;
+    }
+}
+
+/*--------------------------------------------------------------------
+   Observers (stats, monitor): attach read-only to the segment Sales
+   created under 'key'. Returns NULL if there is none.
+----------------------------------------------------------------------*/
+shData *shmemWatch( key_t key , int *shmid )
+{
+    *shmid = shmget( key , 0 , 0 ) ;
+    if ( key == (key_t) -1 || *shmid < 0 )
+        return NULL ;
+
+    shData *shm = (shData *) Shmat( *shmid , NULL , SHM_RDONLY ) ;
+    shmemCheck( shm ) ;
+    return shm ;
+}
+
+/*--------------------------------------------------------------------
+   Observers: has Sales removed the segment we are watching? Once it
+   has, its key no longer finds it.
+----------------------------------------------------------------------*/
+int shmemGone( key_t key , int shmid )
+{
+    return shmget( key , 0 , 0 ) != shmid ;
+}
+
+/*--------------------------------------------------------------------
+   SysV key for the segment ('S') or message queue ('Q') of run
+   'runID'. Two live runs never share a pid, so never share a key
+----------------------------------------------------------------------*/
+key_t shmemKey( int runID , char token )
+{
+    return (key_t) ( ( (unsigned) token << 24 ) | ( (unsigned) runID & RUN_ID_MAX ) ) ;
+}
+
+/*--------------------------------------------------------------------
+   Name of run 'runID's semaphore 'what', e.g. "/Team25_4242_shm_mutex"
+----------------------------------------------------------------------*/
+void runSemName( char *buf , size_t len , int runID , const char *what )
+{
+    snprintf( buf , len , RUN_SEM_PREFIX "%d_%s" , runID , what ) ;
+}
+
+/*--------------------------------------------------------------------
+   Observers given no run ID: find the run whose semaphores are in
+   /dev/shm. Returns its ID, 0 if there is none, -1 if there are
+   several to choose from.
+----------------------------------------------------------------------*/
+int shmemFindRun( void )
+{
+    DIR *d = opendir( "/dev/shm" ) ;
+    if ( ! d )
+        return 0 ;
+
+    // Named semaphores live there as "sem.<name without the '/'>"
+    char fmt[ 64 ] , rest[ 32 ] ;
+    snprintf( fmt , sizeof( fmt ) , "sem.%s%%d_%%31s" , RUN_SEM_PREFIX + 1 ) ;
+
+    int found = 0 , runID ;
+    struct dirent *e ;
+    while ( ( e = readdir( d ) ) )
+    {
+        if ( sscanf( e->d_name , fmt , &runID , rest ) != 2 || strcmp( rest , "shm_mutex" ) != 0 )
+            continue ;
+        found = found ? -1 : runID ;
+    }
+    closedir( d ) ;
+    return found ;
+}
+
+/*--------------------------------------------------------------------
+   One-shot rendezvous in the segment: raise 'flag' and wake all of
+   its waiters, or sleep until somebody has raised it
+----------------------------------------------------------------------*/
+void flagRaise( _Atomic int *flag )
+{
+    atomic_store( flag , 1 ) ;
+    Futex_wake( (int *) flag , INT_MAX ) ;
+}
+
+void flagWait( _Atomic int *flag )
+{
+    while ( ! atomic_load( flag ) )
+        Futex_wait( (int *) flag , 0 ) ;
+}
+
+//------------------
+
+factoryStats *shmStats( shData *shm , int facID )
+{
+    return (factoryStats *) ( (char *) shm + shm->statsOffset ) + facID ;
+}
+
+//------------------
+
+procInstr *shmInstr( shData *shm , int idx )
+{
+    return (procInstr *) ( (char *) shm + shm->instrOffset ) + idx ;
+}
+
+//------------------
+
+reservation *shmResv( shData *shm , int facID )
+{
+    return (reservation *) ( (char *) shm + shm->resvOffset ) + facID ;
+}
+
+/*--------------------------------------------------------------------
+   Factories launched so far. Without --autoscale that is all of them;
+   with it, nFactories is only how many may ever join
+----------------------------------------------------------------------*/
+int shmJoined( shData *shm )
+{
+    return atomic_load( &shm->joined ) & ~SCALE_CLOSED ;
+}
+
+//------------------
+
+msgRing *shmRing( shData *shm )
+{
+    return (msgRing *) ( (char *) shm + shm->ringOffset ) ;
+}
+
+/*--------------------------------------------------------------------
+   Sales: put an order into a free slot and make it claimable.
+   Returns the slot index, or -1 if every slot is in use.
+----------------------------------------------------------------------*/
+int openOrder( shData *shm , int orderID , int size , int deadline )
+{
+    return resumeOrder( shm , orderID , size , deadline , 0 ) ;
+}
+
+/*--------------------------------------------------------------------
+   Sales --resume: the same, for an order of which 'done' parts were
+   already made before a restart. Only the rest is claimable.
+----------------------------------------------------------------------*/
+int resumeOrder( shData *shm , int orderID , int size , int deadline , int done )
+{
+    for ( int i = 0 ; i < MAXORDERS ; i++ )
+    {
+        orderSlot *o = &shm->orders[i] ;
+        if ( atomic_load( &o->state ) != SLOT_FREE )
+            continue ;
+
+        o->orderID    = orderID ;
+        o->order_size = size ;
+        o->deadline   = deadline ;
+        atomic_store( &o->made , done ) ;
+        atomic_store( &o->delivered , done ) ;
+        shm->totalOrdered += size ;
+
+        // With reservations, deal what is left out evenly over the
+        // factories there are, the first (left % N) taking one part more
+        if ( shm->claimMode == CLAIM_STEAL )
+        {
+            int left = size - done , N = shmJoined( shm ) ;
+            for ( int f = 1 ; f <= N ; f++ )
+                atomic_store( &shmResv( shm , f )->left[i] , left / N + ( f <= left % N ) ) ;
+        }
+        atomic_store( &o->remain , size - done ) ;
+
+        // state goes last: factories only look at an open slot, so
+        // one that sees it open is guaranteed to see its orderID,
+        // 'remain' and every reservation already in place
+        atomic_store_explicit( &o->state , SLOT_OPEN , memory_order_release ) ;
+        return i ;
+    }
+    return -1 ;
+}
+
+/*--------------------------------------------------------------------
+   The open slot holding order 'orderID', or NULL
+----------------------------------------------------------------------*/
+orderSlot *findOrder( shData *shm , int orderID )
+{
+    for ( int i = 0 ; i < MAXORDERS ; i++ )
+        if ( atomic_load( &shm->orders[i].state ) == SLOT_OPEN
+             && shm->orders[i].orderID == orderID )
+            return &shm->orders[i] ;
+    return NULL ;
+}
+
+/*--------------------------------------------------------------------
+   Every part of order 'o' has been delivered: hand the slot back to
+   Sales and wake it
+----------------------------------------------------------------------*/
+void completeOrder( shData *shm , orderSlot *o )
+{
+    atomic_store( &o->state , SLOT_DONE ) ;
+    atomic_fetch_add( &shm->ordersDone , 1 ) ;
+    Futex_wake( (int *) &shm->ordersDone , INT_MAX ) ;
+}
@@ -4,18 +4,232 @@
 // Author     : Mohamed Aboutabl
 //---------------------------------------------------------------------
 
+#ifndef SHMEM_H
+#define SHMEM_H
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <limits.h>
 #include <semaphore.h>
+#include <stdatomic.h>
 
-typedef struct 
+#include "ring.h"
+#include "instr.h"
+
+// How factories claim their next batch of parts from 'remain'
+typedef enum
+{
+    CLAIM_ATOMIC = 0 ,      // lock-free compare-and-swap on 'remain'
+    CLAIM_SEM ,             // classic critical section guarded by sem_shm
+    CLAIM_STEAL             // per-factory reservations, idle factories steal
+} claimMode_t ;
+
+// How factories report to the supervisor
+typedef enum
+{
+    TRANSPORT_MSGQ = 0 ,    // System V message queue
+    TRANSPORT_RING          // MPSC ring buffer inside this segment
+} transport_t ;
+
+// Which open order a factory takes its next batch from
+typedef enum
+{
+    ORDER_FIFO = 0 ,        // oldest order first
+    ORDER_EDF               // earliest deadline first
+} orderPolicy_t ;
+
+// How many parts a factory takes per claim
+typedef enum
+{
+    BATCH_FIXED = 0 ,       // min(capacity, remain)
+    BATCH_GUIDED ,          // guided self-scheduling: shrink as remain -> 0
+    BATCH_RATE              // share of remain proportional to capacity/duration
+} batchPolicy_t ;
+
+// Life of an order slot: Sales opens it, the supervisor marks it done
+// once every part has been reported, Sales frees it for reuse
+typedef enum
+{
+    SLOT_FREE = 0 , SLOT_OPEN , SLOT_DONE
+} slotState_t ;
+
+#define MAXORDERS       16      // orders that can be in flight at once
+#define NO_DEADLINE     INT_MAX
+
+// shData.shmNuma when the segment has no explicit policy, or is
+// spread over every node
+#define NUMA_NONE           -1
+#define NUMA_INTERLEAVE     -2
+
+// Every run's IPC names carry its run ID (Sales' pid unless given),
+// so independent runs on one host never meet. Keys keep the ID in
+// their low 24 bits, which holds any Linux pid
+#define RUN_ID_MAX          0xFFFFFF
+#define RUN_SEM_PREFIX      "/Team25_"
+
+// Set in shData.joined by the supervisor once every factory that
+// joined has completed: from then on no factory may join
+#define SCALE_CLOSED        0x40000000
+
+// Bumped whenever the layout below changes, so a factory built from
+// an older tree refuses to attach instead of misreading the segment
+#define SHM_MAGIC       0x54323553      // "T25S"
+#define SHM_VERSION     14
+
+// CLAIM_STEAL: the parts of each order slot set aside for one factory.
+// openOrder deals an order out evenly; the owner then takes batches
+// from its own entry, and only a factory whose entries are all empty
+// touches somebody else's, to take half of the fullest one. Parts are
+// interchangeable, so a reservation is just a count
+typedef struct
+{
+    _Alignas(CACHE_LINE)
+    _Atomic int left[ MAXORDERS ] ;
+} reservation ;
+
+// Fields are grouped by who writes them, and every group starts on its
+// own cache line: the claim counters that factories hammer never share
+// a line with what Sales or the supervisor write, or with the
+// read-mostly configuration every claim reads
+typedef struct
 {
+    // Read-mostly: set by Sales when the order is opened
+    _Alignas(CACHE_LINE)
+    _Atomic int state ;     // one of slotState_t
+    int   orderID ;         // 1, 2, ... in the order Sales posted them
     int   order_size ;
-    int   made ;        // #parts made so far
-    int   remain ;      // #parts remaining to be manufactured
+    int   deadline ;        // ms on Sales' clock, NO_DEADLINE if none
+
+    // Written by every factory on every claim
+    _Alignas(CACHE_LINE)
+    _Atomic int made ;      // #parts made so far
+    _Atomic int remain ;    // #parts remaining to be manufactured
     // When a factory is in the middle of making 'x' parts, made+remain+x = order_size
     // So, it is not always true that made + remain = order_size
 
-    int   activeFactories ;
+    // Written by factories once per finished batch
+    _Alignas(CACHE_LINE)
+    _Atomic int delivered ; // #parts actually produced (stats-in-shm mode)
+} orderSlot ;
+
+// One factory's running totals. Only that factory writes its entry,
+// and each entry has its own cache line so factories never contend
+typedef struct
+{
+    _Alignas(CACHE_LINE)
+    _Atomic int       parts ;   // #parts made
+    _Atomic int       iters ;   // #batches made
+    _Atomic long long busyMs ;  // time spent making them
+    _Atomic long long lastNs ;  // CLOCK_MONOTONIC at the end of the last batch
+
+    // Set by whoever forks the factory process (Sales or the zygote), 0 for a thread
+    int               pid ;
+    _Atomic int       exited ;      // set by the zygote just before it reaps the factory
+    _Atomic long long startedNs ;   // CLOCK_MONOTONIC when runFactory began
+    int               cpu ;         // CPU the factory pinned itself to, -1 if not pinned
+
+    // Simulated-time mode (simclock.c)
+    _Atomic long long vtMs ;    // virtual time this factory's next claim happens at
+    _Atomic int       simGo ;   // futex: bumped when this factory is handed the clock
+
+    // Sales --resume: the totals above as the restart found them,
+    // never written again
+    int               baseParts , baseIters ;
+    long long         baseBusyMs ;
+
+    // Sales --autoscale
+    long long         joinedNs ;    // CLOCK_MONOTONIC when it joined mid-order, 0 if it started with the plant
+    _Atomic int       retire ;      // set by Sales: leave before the next claim
+} factoryStats ;
+
+typedef struct 
+{
+    // Header: identifies the segment and its layout, which is
+    // sized from the number of factories by shmemSize()
+    _Alignas(CACHE_LINE)
+    unsigned magic ;        // SHM_MAGIC
+    unsigned version ;      // SHM_VERSION
+    size_t  size ;          // bytes in the whole segment
+    int     nFactories ;
+    size_t  ringOffset ;    // msgRing, only used when transport == TRANSPORT_RING
+    size_t  statsOffset ;   // factoryStats[ nFactories + 1 ], indexed by factory ID
+    size_t  instrOffset ;   // procInstr[ nFactories + 1 ], 0 = supervisor
+    size_t  resvOffset ;    // reservation[ nFactories + 1 ], only used when claimMode == CLAIM_STEAL
+
+    // Configuration: set by Sales before any factory starts, then read-only
+    _Alignas(CACHE_LINE)
+    int   claimMode ;       // one of claimMode_t
+    int   transport ;       // one of transport_t
+    int   orderPolicy ;     // one of orderPolicy_t
+    int   batchPolicy ;     // one of batchPolicy_t
+    int   statsInShm ;      // supervisor reads factoryStats; only lifecycle events are sent
+    int   streaming ;       // factories and supervisor stay up across many orders
+    int   msgCoalesce ;     // factories send up to this many messages per msgBatch
+    int   flushMs ;         // ... or whatever they hold once the oldest is this old
+    int   logMode ;         // one of logMode_t (logger.h), for factory.log
+    int   simulated ;       // durations advance a virtual clock instead of sleeping
+    int   resumed ;         // --resume: stats entries and the order slot hold the totals made before the restart
+    double timeScale ;      // factories sleep duration * timeScale ms (0: not at all)
+    int   doorbellFd ;      // eventfd waking an idle supervisor, inherited by every child; -1 if none
+    int   pinFactories ;    // factories pin themselves round-robin (placement.c)
+    int   supervisorCpu ;   // CPU the supervisor pins itself to, -1 for none
+    int   shmNuma ;         // NUMA node the segment is bound to, or NUMA_NONE / NUMA_INTERLEAVE
+    double totalRate ;      // sum of capacity/duration over all factories (parts per ms)
+    long long startNs ;     // CLOCK_MONOTONIC when Sales launched the factories
+
+    // Written by Sales as orders come and go
+    _Alignas(CACHE_LINE)
+    _Atomic int workWord ;      // futex: bumped by Sales when an order opens or on shutdown
+    _Atomic int shutdown ;      // no more orders are coming
+    int         totalOrdered ;  // sum of all order sizes posted so far
+    _Atomic int joined ;        // factories launched so far (IDs 1 .. joined), | SCALE_CLOSED at the end
+    _Atomic int pidsPosted ;    // bumped after factoryStats[].pid entries are filled in
+    _Atomic int printOK ;       // futex: Sales lets the supervisor print its final report
+
+    // Written by every factory on every line in LOG_ASYNC_TAGGED mode
+    _Alignas(CACHE_LINE)
+    _Atomic long logSeq ;
+
+    // Set by the supervisor before it sleeps; the first sender to
+    // find it set clears it and rings doorbellFd
+    _Alignas(CACHE_LINE)
+    _Atomic int supIdle ;
+
+    // Written by any process that found a semaphore taken and had to block
+    _Alignas(CACHE_LINE)
+    _Atomic long semWaits ;
+
+    // Written by whichever factory holds the virtual clock (simulated mode)
+    _Alignas(CACHE_LINE)
+    _Atomic int simTurn ;       // ID of the only factory allowed to claim, 0 once all retired
+
+    // Written by the supervisor on every COMPLETION_MSG
+    _Alignas(CACHE_LINE)
+    int         activeFactories ;
+    _Atomic int ordersDone ;    // futex: #orders the supervisor has seen finish
+    _Atomic int supDone ;       // futex: set once every factory has completed
+
+    orderSlot orders[ MAXORDERS ] ;
 } shData ;
 
-#define SHMEM_SIZE      sizeof(shData)
-#define MAXFACTORIES    20
+size_t  shmemSize( int nFactories ) ;
+void    shmemInit( shData *shm , int nFactories ) ;
+void    shmemCheck( shData *shm ) ;
+shData *shmemWatch( key_t key , int *shmid ) ;
+int     shmemGone( key_t key , int shmid ) ;
+key_t   shmemKey( int runID , char token ) ;
+void    runSemName( char *buf , size_t len , int runID , const char *what ) ;
+int     shmemFindRun( void ) ;
+void    flagRaise( _Atomic int *flag ) ;
+void    flagWait( _Atomic int *flag ) ;
+msgRing *shmRing( shData *shm ) ;
+factoryStats *shmStats( shData *shm , int facID ) ;
+procInstr *shmInstr( shData *shm , int idx ) ;
+reservation *shmResv( shData *shm , int facID ) ;
+int     shmJoined( shData *shm ) ;
+int     openOrder( shData *shm , int orderID , int size , int deadline ) ;
+int     resumeOrder( shData *shm , int orderID , int size , int deadline , int done ) ;
+orderSlot *findOrder( shData *shm , int orderID ) ;
+void    completeOrder( shData *shm , orderSlot *o ) ;
+
+#endif
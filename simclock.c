@@ -0,0 +1,101 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+// Simulated-time mode: a conservative discrete-event schedule.
+//
+// Every factory carries a virtual time, the moment its next claim would
+// happen in a real run. Only the factory with the smallest virtual time
+// (ties go to the lower ID) may claim; it then advances its own clock
+// by the batch duration instead of sleeping, and hands the clock to the
+// new minimum. Claims therefore happen in exactly the order an ideal
+// real run would make them, but back to back.
+//----------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "wrappers.h"
+#include "shmem.h"
+#include "simclock.h"
+
+/*--------------------------------------------------------------------
+   Give the clock to the factory with the earliest virtual time and
+   wake only that one. Every other factory keeps sleeping.
+----------------------------------------------------------------------*/
+static void passTurn( shData *shm )
+{
+    int next = 0 ;
+    long long best = SIM_RETIRED ;
+
+    for ( int i = 1 ; i <= shm->nFactories ; i++ )
+    {
+        long long vt = atomic_load( &shmStats( shm , i )->vtMs ) ;
+        if ( vt < best )
+        {
+            best = vt ;
+            next = i ;
+        }
+    }
+
+    // simTurn goes first: a woken factory must find its own ID there
+    atomic_store( &shm->simTurn , next ) ;
+    if ( next == 0 )
+        return ;
+
+    factoryStats *st = shmStats( shm , next ) ;
+    atomic_fetch_add( &st->simGo , 1 ) ;
+    Futex_wake( (int *) &st->simGo , 1 ) ;
+}
+
+/*--------------------------------------------------------------------
+   Sales: every factory starts at virtual time 0, so factory 1 has
+   the clock first
+----------------------------------------------------------------------*/
+void simStart( shData *shm )
+{
+    for ( int i = 1 ; i <= shm->nFactories ; i++ )
+        atomic_store( &shmStats( shm , i )->vtMs , 0 ) ;
+    atomic_store( &shm->simTurn , 1 ) ;
+}
+
+/*--------------------------------------------------------------------
+   Block until 'facID' holds the clock
+----------------------------------------------------------------------*/
+void simWaitTurn( shData *shm , int facID )
+{
+    factoryStats *st = shmStats( shm , facID ) ;
+
+    for ( ;; )
+    {
+        int go = atomic_load( &st->simGo ) ;
+        if ( atomic_load( &shm->simTurn ) == facID )
+            return ;
+        Futex_wait( (int *) &st->simGo , go ) ;
+    }
+}
+
+/*--------------------------------------------------------------------
+   'facID' made a batch taking 'durationMs': move its clock forward,
+   pass the turn on, and return the virtual time the batch ended at
+----------------------------------------------------------------------*/
+long long simAdvance( shData *shm , int facID , int durationMs )
+{
+    factoryStats *st = shmStats( shm , facID ) ;
+    long long vt = atomic_fetch_add( &st->vtMs , durationMs ) + durationMs ;
+
+    passTurn( shm ) ;
+    return vt ;
+}
+
+/*--------------------------------------------------------------------
+   'facID' found nothing left to claim: drop out of the schedule
+----------------------------------------------------------------------*/
+void simRetire( shData *shm , int facID )
+{
+    atomic_store( &shmStats( shm , facID )->vtMs , SIM_RETIRED ) ;
+    passTurn( shm ) ;
+}
@@ -0,0 +1,19 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+
+#include "shmem.h"
+
+// A retired factory's virtual time: it never holds the clock again
+#define SIM_RETIRED     LLONG_MAX
+
+void      simStart( shData *shm ) ;
+void      simWaitTurn( shData *shm , int facID ) ;
+long long simAdvance( shData *shm , int facID , int durationMs ) ;
+void      simRetire( shData *shm , int facID ) ;
+
+#endif
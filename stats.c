@@ -0,0 +1,84 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+// Live view of the instrumentation region of a running Sales.
+// Attaches read-only to the segment of run run_id (the "Run ID" Sales
+// printed; optional while only one run is up) and prints the same
+// summary as the supervisor's final report, every interval_ms until
+// Sales removes the segment. Thread-mode runs keep shData in-process
+// and cannot be watched this way.
+//
+// Usage: stats [-i interval_ms] [-n count] [-r run_id]
+//----------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <pthread.h>
+
+#include "wrappers.h"
+#include "shmem.h"
+#include "instr.h"
+
+int main(int argc, char **argv) {
+    int interval = 1000, count = 0, runID = 0, opt;
+
+    while ((opt = getopt(argc, argv, "i:n:r:")) != -1) {
+        switch (opt) {
+        case 'i':
+            interval = atoi(optarg);
+            break;
+        case 'n':
+            count = atoi(optarg);
+            break;
+        case 'r':
+            runID = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-i interval_ms] [-n count] [-r run_id]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (interval <= 0) {
+        fprintf(stderr, "interval must be positive\n");
+        return 1;
+    }
+
+    // Same key Sales uses; without -r, the only run there is
+    if (runID == 0)
+        runID = shmemFindRun();
+    if (runID < 0) {
+        fprintf(stderr, "Several Sales runs are up; pick one with -r run_id\n");
+        return 1;
+    }
+    key_t key = shmemKey(runID, 'S');
+    int shmid;
+    shData *shm = runID ? shmemWatch(key, &shmid) : NULL;
+    if (!shm) {
+        fprintf(stderr, "No Sales run to watch\n");
+        return 1;
+    }
+
+    for (int i = 1; count == 0 || i <= count; i++) {
+        printf("\n****** STATS: %.1f ms after launch, %d of %d factories active ******\n",
+               shm->startNs ? (Clock_ns() - shm->startNs) / 1e6 : 0.0,
+               shm->activeFactories, shm->nFactories);
+        instrReport(stdout, shmInstr(shm, 0), shm->nFactories);
+        fflush(stdout);
+
+        // Sales removed the segment: this was the last look
+        if (shmemGone(key, shmid))
+            break;
+        Usleep((useconds_t)interval * 1000);
+    }
+
+    Shmdt(shm);
+    return 0;
+}
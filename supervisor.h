@@ -0,0 +1,28 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <stdio.h>
+#include <semaphore.h>
+
+#include "shmem.h"
+
+// Everything the supervisor needs, whether it runs as its own
+// process (supervisor.c) or as a thread inside Sales (--threads)
+typedef struct
+{
+    int     N ;
+    shData *shm ;
+    int     msgid ;
+    FILE   *log ;           // supervisor.log
+    int     sigfd ;         // signalfd for SIGINT / SIGTERM, -1 when run as a thread
+} supervisorArgs ;
+
+int   runSupervisor( supervisorArgs *a ) ;
+void *supervisorThread( void *arg ) ;
+
+#endif
@@ -0,0 +1,457 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/resource.h>
+
+#include "wrappers.h"
+#include "message.h"
+#include "shmem.h"
+#include "transport.h"
+#include "supervisor.h"
+#include "logger.h"
+#include "trace.h"
+#include "placement.h"
+
+// Most records handled per wakeup; room for several full msgBatches
+#define SUPERVISOR_BURST    (8 * MSG_BATCH_MAX)
+
+// Queue-to-receipt latency of every message, for the final report
+typedef struct {
+    long long *ns;
+    int        count, cap;
+} latencyLog;
+
+static void recordLatency(latencyLog *l, long long ns) {
+    if (l->count == l->cap) {
+        l->cap = l->cap ? 2 * l->cap : 4096;
+        l->ns = realloc(l->ns, l->cap * sizeof(long long));
+        if (!l->ns) {
+            perror("realloc");
+            exit(2);
+        }
+    }
+    l->ns[l->count++] = ns;
+}
+
+static int cmpLongLong(const void *x, const void *y) {
+    long long a = *(const long long*)x, b = *(const long long*)y;
+    return (a > b) - (a < b);
+}
+
+// The p-th percentile (0..100) in microseconds; sorts the log
+static double latencyPercentile(latencyLog *l, double p) {
+    if (l->count == 0)
+        return 0;
+    qsort(l->ns, l->count, sizeof(long long), cmpLongLong);
+    return l->ns[(int)((l->count - 1) * p / 100.0 + 0.5)] / 1e3;
+}
+
+// epoll tags: factory IDs tag their pidfds, these tag the rest
+#define TAG_DOORBELL    0u
+#define TAG_SIGNAL      0xFFFFFFFFu
+
+// pidfd[] of a factory we could not get a pidfd for
+#define PIDFD_UNWATCHED -2
+
+// Descriptors kept free for everything besides the pidfds
+#define FD_SLACK        64
+
+// Everything the event loop keeps between wakeups
+typedef struct {
+    supervisorArgs *a;
+    shData     *shm;
+    FILE       *out;
+    traceWriter *tw;            // supervisor.trace in LOG_BINARY mode
+    procInstr  *in;
+    int        *parts, *iters;
+    long long  *busy;           // time each factory spent making parts
+    bool       *completed;      // COMPLETION_MSG seen (or the factory died)
+    int        *pidfd;          // -1 until Sales posts the factory's pid, or PIDFD_UNWATCHED
+    int         active;         // factories still expected to report
+    int         joined;         // factories launched so far, as far as we know
+    int         pidsSeen;       // last shm->pidsPosted we acted on
+    int         unwatched;      // factories left without a pidfd
+    int         ep;             // epoll instance
+    latencyLog  lat;
+
+    // Parts and batches received so far for each open order, by slot
+    int orderMade[MAXORDERS], orderBatches[MAXORDERS];
+} supState;
+
+// Handle one report from a factory
+static void handleMsg(supState *s, msgBuf *m, long long nowNs) {
+    shData *shm = s->shm;
+    FILE *out = s->out;
+
+    recordLatency(&s->lat, nowNs - m->queuedNs);
+    histRecord(&s->in->deliver, nowNs - m->queuedNs);
+
+    // Trace it when it happened: on receipt, or in simulated time at
+    // the factory's virtual clock
+    long long atNs = shm->simulated ? m->simNs : nowNs;
+
+    if (m->purpose == PRODUCTION_MSG) {
+        if (s->tw)
+            traceEventAt(s->tw, atNs, EV_SUP_PRODUCED, m->facID, m->orderID, m->partsMade, m->duration);
+        else
+            fprintf(out, FMT_SUP_PRODUCED, m->facID, m->partsMade, m->duration);
+        s->parts[m->facID] += m->partsMade;
+        s->iters[m->facID] += 1;
+        s->busy[m->facID] += (long long)(m->duration * shm->timeScale);
+
+        // Once an order is fully reported no message for it can
+        // still be in flight, so hand its slot back to Sales
+        orderSlot *o = findOrder(shm, m->orderID);
+        if (o) {
+            int slot = o - shm->orders;
+            s->orderMade[slot] += m->partsMade;
+            s->orderBatches[slot] += 1;
+            if (s->orderMade[slot] == o->order_size) {
+                if (shm->streaming)
+                    fprintf(out, "SUPERVISOR: Order # %d of %5d parts is complete after %4d batches\n",
+                            m->orderID, s->orderMade[slot], s->orderBatches[slot]);
+                s->orderMade[slot] = s->orderBatches[slot] = 0;
+                completeOrder(shm, o);
+            }
+        }
+    } else if (m->purpose == STARTED_MSG) {
+        if (s->tw)
+            traceEventAt(s->tw, atNs, EV_SUP_STARTED, m->facID, 0, 0, 0);
+        else
+            fprintf(out, FMT_SUP_STARTED, m->facID);
+    } else if (m->purpose == COMPLETION_MSG && !s->completed[m->facID]) {
+        if (s->tw)
+            traceEventAt(s->tw, atNs, EV_SUP_COMPLETED, m->facID, 0, 0, 0);
+        else
+            fprintf(out, FMT_SUP_COMPLETED, m->facID);
+        s->completed[m->facID] = true;
+        s->active--;
+        shm->activeFactories -= 1;
+    }
+}
+
+// Done waiting once every factory that joined has completed. Sales
+// --autoscale may launch more as long as the order runs, so take in
+// any that joined since we last looked, then close the door, unless
+// another slips in first
+static bool allCompleted(supState *s) {
+    for (;;) {
+        int j = atomic_load(&s->shm->joined);
+        if (j > s->joined) {
+            s->active += j - s->joined;
+            s->shm->activeFactories += j - s->joined;
+            s->joined = j;
+        }
+        if (s->active > 0)
+            return false;
+        if (atomic_compare_exchange_strong(&s->shm->joined, &j, j | SCALE_CLOSED))
+            return true;
+    }
+}
+
+// Handle everything queued right now; returns how many records
+// there were
+static int drainReports(supState *s) {
+    msgBuf burst[SUPERVISOR_BURST];
+    int total = 0, n;
+
+    // How far behind we are as we start
+    int depth = queueDepth(s->shm, s->a->msgid);
+    if (depth >= 0)
+        histRecord(&s->in->depth, depth);
+
+    while ((n = recvBurst(s->shm, s->a->msgid, s->in, burst, SUPERVISOR_BURST)) != 0) {
+        if (n < 0) {
+            perror("supervisor msgrcv");
+            break;
+        }
+        long long nowNs = Clock_ns();
+        for (int b = 0; b < n; b++)
+            handleMsg(s, &burst[b], nowNs);
+        total += n;
+
+        if (s->shm->logMode == LOG_SYNC)
+            fflush(s->out);
+    }
+    return total;
+}
+
+// Factory 'id' exited. Anything it sent before dying is already
+// queued, so take that in first; if its COMPLETION_MSG was not among
+// it, the factory died and nobody should wait for it any longer
+static void factoryExited(supState *s, int id) {
+    if (s->pidfd[id] >= 0)
+        close(s->pidfd[id]);    // also drops it from the epoll set
+    s->pidfd[id] = -1;
+
+    drainReports(s);
+    if (s->completed[id])
+        return;
+
+    fprintf(s->out, "SUPERVISOR: Factory # %2d DIED before completing its task\n", id);
+    s->completed[id] = true;
+    s->active--;
+    s->shm->activeFactories -= 1;
+}
+
+// Sales posted more factory pids: watch each of them for exit
+static void watchNewFactories(supState *s) {
+    int posted = atomic_load(&s->shm->pidsPosted);
+    if (posted == s->pidsSeen)
+        return;
+    s->pidsSeen = posted;
+
+    for (int i = 1; i <= s->shm->nFactories; i++) {
+        int pid = shmStats(s->shm, i)->pid;
+        if (pid <= 0 || s->pidfd[i] != -1 || s->completed[i])
+            continue;
+        // Sales reaps its children only once we are done, but the
+        // zygote reaps its own as they exit, marking each one first.
+        // Gone (ESRCH), or marked by the time we hold a pidfd, means
+        // it exited; the pidfd may even be for a reused pid
+        factoryStats *st = shmStats(s->shm, i);
+        s->pidfd[i] = Pidfd_open(pid);
+        if (s->pidfd[i] >= 0 && !atomic_load(&st->exited)) {
+            Epoll_add(s->ep, s->pidfd[i], (unsigned)i);
+        } else if (s->pidfd[i] >= 0 || errno == ESRCH) {
+            factoryExited(s, i);
+        } else if (errno == EMFILE || errno == ENFILE) {
+            // Out of descriptors: this one's COMPLETION_MSG is all we
+            // go by, and its death goes unnoticed
+            if (s->unwatched++ == 0)
+                fprintf(s->out, "SUPERVISOR: Out of file descriptors; Factory # %2d and some others are not watched for exit\n", i);
+            s->pidfd[i] = PIDFD_UNWATCHED;
+        }
+    }
+}
+
+// One pidfd per factory process: raise our soft descriptor limit as
+// far as the hard one allows, so thousands of factories fit
+static void roomForPidfds(int N) {
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) < 0)
+        return;
+    rlim_t want = (rlim_t)N + FD_SLACK;
+    if (rl.rlim_cur == RLIM_INFINITY || rl.rlim_cur >= want)
+        return;
+    rl.rlim_cur = (rl.rlim_max == RLIM_INFINITY || rl.rlim_max > want) ? want : rl.rlim_max;
+    if (setrlimit(RLIMIT_NOFILE, &rl) < 0)
+        perror("supervisor setrlimit");
+}
+
+// Collects reports until every factory completes (or dies), then
+// prints the final report once Sales gives permission. Everything is
+// driven from one epoll set: the eventfd doorbell factories ring when
+// we are idle, a pidfd per factory process, and (as a process) a
+// signalfd. Reports themselves are drained without ever blocking
+int runSupervisor(supervisorArgs *a) {
+    shData *shm = a->shm;
+    FILE *out = a->log;
+
+    supState s;
+    memset(&s, 0, sizeof(s));
+    s.a = a;
+    s.shm = shm;
+    s.out = out;
+    s.in = shmInstr(shm, 0);
+    s.active = s.joined = a->N;
+
+    // Allocate arrays for the factories' parts and iterations, room
+    // for every factory that may join (a->N of them start)
+    int N = shm->nFactories;
+    s.parts = calloc(N + 1, sizeof(int));
+    s.iters = calloc(N + 1, sizeof(int));
+    s.busy = calloc(N + 1, sizeof(long long));
+    s.completed = calloc(N + 1, sizeof(bool));
+    s.pidfd = malloc((N + 1) * sizeof(int));
+    if (!s.parts || !s.iters || !s.busy || !s.completed || !s.pidfd) {
+        perror("calloc");
+        return 2;
+    }
+    int *parts = s.parts, *iters = s.iters;
+    long long *busy = s.busy;
+    for (int i = 0; i <= N; i++)
+        s.pidfd[i] = -1;
+
+    // A resumed run starts from the parts and batches made before
+    // the restart, which Sales kept aside in the stats entries and the
+    // order slot. Never from the live totals: factories may already be
+    // adding to them, and every batch they made would be counted again
+    // when reported. busy[] stays this run's own, since the makespan
+    // is measured from this run's launch
+    if (shm->resumed) {
+        for (int i = 1; i <= N; i++) {
+            factoryStats *st = shmStats(shm, i);
+            parts[i] = st->baseParts;
+            iters[i] = st->baseIters;
+        }
+        for (int i = 0; i < MAXORDERS; i++)
+            if (atomic_load(&shm->orders[i].state) == SLOT_OPEN)
+                s.orderMade[i] = atomic_load(&shm->orders[i].delivered);
+    }
+
+    fprintf(out, "\nSUPERVISOR: Started\n");
+
+    // A dedicated CPU, if Sales gave us one
+    if (shm->supervisorCpu >= 0 && pinSelf(shm->supervisorCpu) < 0)
+        perror("supervisor pin");
+
+    // In LOG_BINARY mode per-message lines become supervisor.trace records
+    traceWriter *tw = (shm->logMode == LOG_BINARY) ? traceOpen(SUPERVISOR_TRACE) : NULL;
+    s.tw = tw;
+
+    roomForPidfds(N);
+    s.ep = Epoll_create();
+    Epoll_add(s.ep, shm->doorbellFd, TAG_DOORBELL);
+    if (a->sigfd >= 0)
+        Epoll_add(s.ep, a->sigfd, TAG_SIGNAL);
+
+    bool stop = false;
+    while (!stop && !allCompleted(&s)) {
+        if (drainReports(&s) > 0)
+            continue;
+
+        // Nothing queued: say we are idle, then look once more, so a
+        // report sent just before the flag went up is not slept on
+        atomic_store(&shm->supIdle, 1);
+        if (drainReports(&s) > 0) {
+            atomic_store(&shm->supIdle, 0);
+            continue;
+        }
+        watchNewFactories(&s);
+
+        // With the async logs, let stdio batch our lines, but not
+        // across a sleep
+        if (shm->logMode != LOG_SYNC)
+            fflush(out);
+
+        struct epoll_event ev[16];
+        int n = epoll_wait(s.ep, ev, 16, -1);
+        atomic_store(&shm->supIdle, 0);
+        if (n < 0) {
+            if (errno != EINTR)
+                perror("supervisor epoll_wait");
+            continue;
+        }
+
+        for (int e = 0; e < n; e++) {
+            unsigned tag = ev[e].data.u32;
+            if (tag == TAG_DOORBELL) {
+                uint64_t rings;
+                if (read(shm->doorbellFd, &rings, sizeof(rings)) < 0 && errno != EAGAIN)
+                    perror("supervisor doorbell");
+            } else if (tag == TAG_SIGNAL) {
+                struct signalfd_siginfo si;
+                if (read(a->sigfd, &si, sizeof(si)) == sizeof(si))
+                    fprintf(out, "SUPERVISOR: Caught signal %d, reporting on what was made so far\n",
+                            (int)si.ssi_signo);
+                stop = true;
+            } else if (s.pidfd[tag] >= 0) {
+                factoryExited(&s, (int)tag);
+            }
+        }
+    }
+
+    for (int i = 1; i <= N; i++)
+        if (s.pidfd[i] >= 0)
+            close(s.pidfd[i]);
+    close(s.ep);
+    free(s.pidfd);
+    free(s.completed);
+    latencyLog lat = s.lat;
+
+    if (tw)
+        traceClose(tw);
+
+    // Rendezvous
+    fprintf(out, "\nSUPERVISOR: Manufacturing is complete. Awaiting permission to print final report\n");
+    fflush(out);
+    flagRaise(&shm->supDone);   // done
+    flagWait(&shm->printOK);    // wait for Sales
+
+    // Every factory has completed, so its stats entry is final. The
+    // makespan ends when the last batch was made, not when it reached
+    // us, which coalesced reports can delay. With stats in shared
+    // memory the totals were never sent to us at all
+    N = s.joined;
+    long long lastNs = shm->startNs;
+    for (int i = 1; i <= N; i++) {
+        factoryStats *st = shmStats(shm, i);
+        if (atomic_load(&st->lastNs) > lastNs)
+            lastNs = atomic_load(&st->lastNs);
+        if (shm->statsInShm) {
+            parts[i] = atomic_load(&st->parts);
+            iters[i] = atomic_load(&st->iters);
+            busy[i]  = atomic_load(&st->busyMs) - st->baseBusyMs;
+        }
+    }
+
+    // Final report
+    fprintf(out, "\n****** SUPERVISOR: Final Report ******\n");
+    int grand = 0;
+    for (int i = 1; i <= N; i++) {
+        factoryStats *st = shmStats(shm, i);
+        fprintf(out, "Factory # %2d made a total of %4d parts in %5d iterations", i, parts[i], iters[i]);
+        if (st->joinedNs)
+            fprintf(out, "   joined at %.1f ms", (st->joinedNs - shm->startNs) / 1e6);
+        if (atomic_load(&st->retire))
+            fprintf(out, "   retired early");
+        fputc('\n', out);
+        grand += parts[i];
+    }
+    fprintf(out, "==============================\n");
+    fprintf(out, "Grand total parts made = %5d   vs  order size of %5d\n", grand, shm->totalOrdered);
+
+    // Makespan runs from launch to the last reported batch; whatever
+    // part of it a factory did not spend making parts was idle. A
+    // factory that joined late, or retired early, is only held to the
+    // part of the makespan it was there for
+    double makespan = (lastNs - shm->startNs) / 1e6, idle = 0, present = 0;
+    for (int i = 1; i <= N; i++) {
+        factoryStats *st = shmStats(shm, i);
+        long long from = st->joinedNs ? st->joinedNs : shm->startNs, to = lastNs;
+        if (atomic_load(&st->retire) && atomic_load(&st->lastNs) > from)
+            to = atomic_load(&st->lastNs);
+        double there = to > from ? (to - from) / 1e6 : 0;
+        present += there;
+        if (there > busy[i])
+            idle += there - busy[i];
+    }
+    fprintf(out, "Makespan = %8.1f ms   Factory idle time = %10.1f ms (%5.1f%% of %d factories x makespan)\n",
+            makespan, idle, present > 0 ? 100.0 * idle / present : 0.0, N);
+    double p50 = latencyPercentile(&lat, 50), p99 = latencyPercentile(&lat, 99);
+    fprintf(out, "Messages = %7d   latency p50 = %9.1f us   p99 = %9.1f us   Semaphore waits = %ld\n",
+            lat.count, p50, p99, atomic_load(&shm->semWaits));
+    placementReport(out, shm);
+    fprintf(out, "\n****** SUPERVISOR: Instrumentation ******\n");
+    instrReport(out, shmInstr(shm, 0), N);
+    fflush(out);
+
+    // Free mem
+    free(lat.ns);
+    free(parts);
+    free(iters);
+    free(busy);
+    return 0;
+}
+
+// Thread entry point used by Sales in --threads mode
+void *supervisorThread(void *arg) {
+    runSupervisor((supervisorArgs*)arg);
+    return NULL;
+}
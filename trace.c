@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "wrappers.h"
+#include "trace.h"
+
+/*--------------------------------------------------------------------
+   Write all of 'len' bytes, retrying short writes and EINTR
+----------------------------------------------------------------------*/
+static void writeAll( int fd , const void *p , size_t len )
+{
+    const char *c = p ;
+
+    while ( len > 0 )
+    {
+        ssize_t n = write( fd , c , len ) ;
+        if ( n < 0 )
+        {
+            if ( errno == EINTR )
+                continue ;
+            unix_error( "trace write failed" ) ;
+        }
+        c += n ;
+        len -= n ;
+    }
+}
+
+/*--------------------------------------------------------------------
+   Sales: start a fresh trace file holding just the header
+----------------------------------------------------------------------*/
+void traceCreate( const char *path , long long originNs )
+{
+    int fd = open( path , O_WRONLY | O_CREAT | O_TRUNC , S_IRUSR | S_IWUSR ) ;
+    if ( fd < 0 )
+        unix_error( "Failed to create trace file" ) ;
+
+    traceHeader h = { TRACE_MAGIC , TRACE_VERSION , originNs } ;
+    writeAll( fd , &h , sizeof( h ) ) ;
+    close( fd ) ;
+}
+
+/*--------------------------------------------------------------------
+   Open a trace file Sales created, for appending. Each writer's
+   blocks are whole records, so many writers can share one file.
+----------------------------------------------------------------------*/
+traceWriter *traceOpen( const char *path )
+{
+    traceWriter *tw = malloc( sizeof( traceWriter ) ) ;
+    if ( tw == NULL )
+        unix_error( "traceOpen failed" ) ;
+
+    tw->fd = open( path , O_WRONLY | O_APPEND ) ;
+    if ( tw->fd < 0 )
+        unix_error( "Failed to open trace file" ) ;
+    tw->count = 0 ;
+    return tw ;
+}
+
+//------------------
+
+void traceEvent( traceWriter *tw , int event , int facID , int orderID , int a , int b )
+{
+    traceEventAt( tw , Clock_ns() , event , facID , orderID , a , b ) ;
+}
+
+/*--------------------------------------------------------------------
+   Same, for an event that happened at 'ns' rather than now
+----------------------------------------------------------------------*/
+void traceEventAt( traceWriter *tw , long long ns , int event , int facID , int orderID , int a , int b )
+{
+    traceRec *r = &tw->buf[ tw->count++ ] ;
+
+    r->ns = ns ;
+    r->facID = facID ;
+    r->event = event ;
+    r->orderID = orderID ;
+    r->a = a ;
+    r->b = b ;
+
+    if ( tw->count == TRACE_BUF_RECS )
+        traceFlush( tw ) ;
+}
+
+//------------------
+
+void traceFlush( traceWriter *tw )
+{
+    if ( tw->count > 0 )
+        writeAll( tw->fd , tw->buf , tw->count * sizeof( traceRec ) ) ;
+    tw->count = 0 ;
+}
+
+//------------------
+
+void traceClose( traceWriter *tw )
+{
+    traceFlush( tw ) ;
+    close( tw->fd ) ;
+    free( tw ) ;
+}
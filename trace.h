@@ -0,0 +1,71 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef TRACE_H
+#define TRACE_H
+
+// The text lines factory.log and supervisor.log have always held.
+// Shared by the live loggers and by tracedump, so a decoded trace
+// reads exactly like a text log
+#define FMT_FACTORY_STARTED   "Factory # %2d: STARTED. My Capacity = %3d, in %4d milliSeconds\n"
+#define FMT_FACTORY_BATCH     "Factory # %2d: Going to make   %3d parts in %4d milliSecs\n"
+#define FMT_FACTORY_DONE      ">>> Factory #  %2d: Terminating after making total of %4d parts in %3d iterations\n"
+#define FMT_SUP_PRODUCED      "SUPERVISOR: Factory # %2d produced  %3d parts in %4d milliSecs\n"
+#define FMT_SUP_STARTED       "SUPERVISOR: Factory # %2d        STARTED its task\n"
+#define FMT_SUP_COMPLETED     "SUPERVISOR: Factory # %2d        COMPLETED its task\n"
+
+#define TRACE_MAGIC     0x52543235      // "25TR"
+#define TRACE_VERSION   2
+
+#define FACTORY_TRACE       "factory.trace"
+#define SUPERVISOR_TRACE    "supervisor.trace"
+
+// One event. 'a' and 'b' are the two numbers of the matching text line
+typedef enum
+{
+    EV_FACTORY_STARTED = 1 ,    // a = capacity , b = duration
+    EV_FACTORY_BATCH ,          // a = parts    , b = duration
+    EV_FACTORY_DONE ,           // a = parts    , b = iterations
+    EV_SUP_PRODUCED ,           // a = parts    , b = duration
+    EV_SUP_STARTED ,
+    EV_SUP_COMPLETED
+} traceEvent_t ;
+
+typedef struct
+{
+    long long ns ;              // CLOCK_MONOTONIC; under --sim, startNs + virtual time
+    int       facID ;
+    int       event ;           // one of traceEvent_t
+    int       orderID ;         // batches: the order they belong to, else 0
+    int       a , b ;
+} traceRec ;
+
+// Written once at the start of each trace file
+typedef struct
+{
+    unsigned  magic ;           // TRACE_MAGIC
+    unsigned  version ;         // TRACE_VERSION
+    long long originNs ;        // when Sales launched the factories
+} traceHeader ;
+
+// Records are buffered per writer and written in blocks, so logging
+// an event is a copy into memory
+#define TRACE_BUF_RECS  256
+
+typedef struct
+{
+    int       fd ;
+    int       count ;
+    traceRec  buf[ TRACE_BUF_RECS ] ;
+} traceWriter ;
+
+void         traceCreate( const char *path , long long originNs ) ;
+traceWriter *traceOpen( const char *path ) ;
+void         traceEvent( traceWriter *tw , int event , int facID , int orderID , int a , int b ) ;
+void         traceEventAt( traceWriter *tw , long long ns , int event , int facID , int orderID , int a , int b ) ;
+void         traceFlush( traceWriter *tw ) ;
+void         traceClose( traceWriter *tw ) ;
+
+#endif
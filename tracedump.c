@@ -0,0 +1,121 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+// Offline decoder for factory.trace / supervisor.trace.
+// Prints the same lines factory.log and supervisor.log would have held.
+// Several files are merged into one timeline.
+//
+// Usage: tracedump [-t] [-o] <trace_file>...
+//   -t   prefix every line with its time since launch, in ms
+//   -o   prefix batch lines with the order they belong to
+//----------------------------------------------------------------------
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+// A record and where it was loaded, so sorting can keep file order
+typedef struct {
+    traceRec r;
+    size_t   seq;
+} loadedRec;
+
+static loadedRec *recs = NULL;
+static size_t nrecs = 0, caprecs = 0;
+
+// Appends every record of one trace file; returns its origin
+static long long load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        exit(1);
+    }
+
+    traceHeader h;
+    if (fread(&h, sizeof(h), 1, f) != 1 || h.magic != TRACE_MAGIC || h.version != TRACE_VERSION) {
+        fprintf(stderr, "%s: not a version %d trace file\n", path, TRACE_VERSION);
+        exit(1);
+    }
+
+    traceRec r;
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        if (nrecs == caprecs) {
+            caprecs = caprecs ? 2 * caprecs : 4096;
+            recs = realloc(recs, caprecs * sizeof(loadedRec));
+            if (!recs) {
+                perror("realloc");
+                exit(1);
+            }
+        }
+        recs[nrecs].r = r;
+        recs[nrecs].seq = nrecs;
+        nrecs++;
+    }
+    fclose(f);
+    return h.originNs;
+}
+
+// Orders records by time; equal times keep the order they were
+// loaded in, which qsort on its own would not
+static int by_time(const void *x, const void *y) {
+    const loadedRec *a = x, *b = y;
+    if (a->r.ns != b->r.ns)
+        return a->r.ns < b->r.ns ? -1 : 1;
+    return a->seq < b->seq ? -1 : (a->seq > b->seq);
+}
+
+int main(int argc, char **argv) {
+    int stamps = 0, orders = 0, opt;
+
+    while ((opt = getopt(argc, argv, "to")) != -1) {
+        if (opt == 't')
+            stamps = 1;
+        else if (opt == 'o')
+            orders = 1;
+        else {
+            fprintf(stderr, "Usage: %s [-t] [-o] <trace_file>...\n", argv[0]);
+            return 1;
+        }
+    }
+    if (optind == argc) {
+        fprintf(stderr, "Usage: %s [-t] [-o] <trace_file>...\n", argv[0]);
+        return 1;
+    }
+
+    long long origin = 0;
+    for (int i = optind; i < argc; i++)
+        origin = load(argv[i]);
+
+    // Each writer's records are in order already, but every factory
+    // appends its own blocks to factory.trace, so even one file is
+    // several writers interleaved and is always merged by time
+    qsort(recs, nrecs, sizeof(loadedRec), by_time);
+
+    for (size_t i = 0; i < nrecs; i++) {
+        traceRec *r = &recs[i].r;
+
+        if (stamps)
+            printf("[%10.3f] ", (r->ns - origin) / 1e6);
+        if (orders && r->orderID)
+            printf("<order %d> ", r->orderID);
+
+        switch (r->event) {
+        case EV_FACTORY_STARTED: printf(FMT_FACTORY_STARTED, r->facID, r->a, r->b); break;
+        case EV_FACTORY_BATCH:   printf(FMT_FACTORY_BATCH,   r->facID, r->a, r->b); break;
+        case EV_FACTORY_DONE:    printf(FMT_FACTORY_DONE,    r->facID, r->a, r->b); break;
+        case EV_SUP_PRODUCED:    printf(FMT_SUP_PRODUCED,    r->facID, r->a, r->b); break;
+        case EV_SUP_STARTED:     printf(FMT_SUP_STARTED,     r->facID);             break;
+        case EV_SUP_COMPLETED:   printf(FMT_SUP_COMPLETED,   r->facID);             break;
+        default:                 printf("?? unknown event %d from factory %d\n", r->event, r->facID);
+        }
+    }
+
+    free(recs);
+    return 0;
+}
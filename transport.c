@@ -0,0 +1,173 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/ipc.h>
+#include <sys/msg.h>
+
+#include "wrappers.h"
+#include "transport.h"
+#include "ring.h"
+
+/*--------------------------------------------------------------------
+   After a send: if the supervisor went idle waiting for reports, wake
+   it through its eventfd. Only the first sender to see it idle pays
+   for the write.
+----------------------------------------------------------------------*/
+void wakeSupervisor( shData *shm )
+{
+    if ( shm->doorbellFd >= 0 && atomic_exchange( &shm->supIdle , 0 ) )
+    {
+        uint64_t one = 1 ;
+
+        // Nonblocking, so the only failure is EAGAIN: the counter is
+        // already full of wakeups the supervisor has yet to read, and
+        // it drains every report once it does
+        (void) write( shm->doorbellFd , &one , sizeof( one ) ) ;
+    }
+}
+
+/*--------------------------------------------------------------------
+   Factory -> Supervisor: send one message over the transport chosen
+   by Sales. Returns 0 on success, -1 (with errno set) on failure.
+----------------------------------------------------------------------*/
+int sendMsg( shData *shm , int msgid , msgBuf *m )
+{
+    if ( shm->transport == TRANSPORT_RING )
+        ringSend( shmRing( shm ) , m ) ;
+    else if ( msgsnd( msgid , m , MSG_INFO_SIZE , 0 ) < 0 )
+        return -1 ;
+
+    wakeSupervisor( shm ) ;
+    return 0 ;
+}
+
+/*--------------------------------------------------------------------
+   Factory -> Supervisor: send the records coalesced in 'b' as one
+   message. The ring already costs no syscall per record, so there
+   the records are simply pushed one by one.
+   Returns 0 on success, -1 (with errno set) on failure.
+----------------------------------------------------------------------*/
+int sendBatch( shData *shm , int msgid , msgBatch *b )
+{
+    if ( shm->transport == TRANSPORT_RING )
+    {
+        for ( int i = 0 ; i < b->count ; i++ )
+            ringSend( shmRing( shm ) , &b->recs[i] ) ;
+    }
+    else
+    {
+        b->mtype = MSG_TYPE_BATCH ;
+        if ( msgsnd( msgid , b , MSG_BATCH_SIZE( b->count ) , 0 ) < 0 )
+            return -1 ;
+    }
+
+    wakeSupervisor( shm ) ;
+    return 0 ;
+}
+
+/*--------------------------------------------------------------------
+   Supervisor: drain, without ever blocking, whatever is queued until
+   the queue is empty or 'out' is full. Batches are unpacked, so 'out'
+   holds individual records. 'max' must be at least MSG_BATCH_MAX.
+   Every receive that got something, one msgrcv or ring pop, is timed
+   into in->recv. Returns the number of records (0 if nothing was
+   queued), or -1 (with errno set) on failure.
+----------------------------------------------------------------------*/
+int recvBurst( shData *shm , int msgid , procInstr *in , msgBuf *out , int max )
+{
+    int n = 0 ;
+    long long t0 = Clock_ns() ;
+
+    if ( shm->transport == TRANSPORT_RING )
+    {
+        while ( n < max && ringTryRecv( shmRing( shm ) , &out[n] ) )
+        {
+            n++ ;
+            long long t1 = Clock_ns() ;
+            histRecord( &in->recv , t1 - t0 ) ;
+            t0 = t1 ;
+        }
+        return n ;
+    }
+
+    msgBatch b ;
+    while ( n + MSG_BATCH_MAX <= max )
+    {
+        if ( msgrcv( msgid , &b , MSG_BATCH_SIZE( MSG_BATCH_MAX ) , 0 , IPC_NOWAIT ) < 0 )
+        {
+            if ( errno == ENOMSG || errno == EINTR )
+                break ;
+            return -1 ;
+        }
+        long long t1 = Clock_ns() ;
+        histRecord( &in->recv , t1 - t0 ) ;
+        t0 = t1 ;
+
+        if ( b.mtype == MSG_TYPE_BATCH )
+        {
+            memcpy( &out[n] , b.recs , b.count * sizeof( msgBuf ) ) ;
+            n += b.count ;
+        }
+        else
+            // A single msgBuf landed at the front of the batch buffer
+            memcpy( &out[ n++ ] , &b , sizeof( msgBuf ) ) ;
+    }
+    return n ;
+}
+
+/*--------------------------------------------------------------------
+   Supervisor: how many messages are waiting right now. On the message
+   queue a coalesced batch counts as one. Returns -1 if it cannot tell.
+----------------------------------------------------------------------*/
+int queueDepth( shData *shm , int msgid )
+{
+    if ( shm->transport == TRANSPORT_RING )
+    {
+        // We are the consumer, so 'head' is ours to read
+        msgRing *r = shmRing( shm ) ;
+        return (int) ( atomic_load_explicit( &r->tail , memory_order_relaxed ) - r->head ) ;
+    }
+
+    struct msqid_ds ds ;
+    if ( msgctl( msgid , IPC_STAT , &ds ) < 0 )
+        return -1 ;
+    return (int) ds.msg_qnum ;
+}
+
+/*--------------------------------------------------------------------
+   Supervisor: block until the next single message arrives.
+   Returns 0 on success, -1 (with errno set) on failure.
+----------------------------------------------------------------------*/
+int recvMsg( shData *shm , int msgid , msgBuf *m )
+{
+    if ( shm->transport == TRANSPORT_RING )
+    {
+        ringRecv( shmRing( shm ) , m ) ;
+        return 0 ;
+    }
+    return ( msgrcv( msgid , m , MSG_INFO_SIZE , 0 , 0 ) < 0 ) ? -1 : 0 ;
+}
+
+/*--------------------------------------------------------------------
+   Convert transports to / from their command-line names
+----------------------------------------------------------------------*/
+const char *transportName( int transport )
+{
+    return ( transport == TRANSPORT_RING ) ? "ring" : "msgq" ;
+}
+
+int transportFromName( const char *name )
+{
+    if ( strcmp( name , "msgq" ) == 0 )
+        return TRANSPORT_MSGQ ;
+    if ( strcmp( name , "ring" ) == 0 )
+        return TRANSPORT_RING ;
+    return -1 ;
+}
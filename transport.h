@@ -0,0 +1,21 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include "message.h"
+#include "shmem.h"
+
+int  sendMsg( shData *shm , int msgid , msgBuf *m ) ;
+int  recvMsg( shData *shm , int msgid , msgBuf *m ) ;
+int  sendBatch( shData *shm , int msgid , msgBatch *b ) ;
+int  recvBurst( shData *shm , int msgid , procInstr *in , msgBuf *out , int max ) ;
+int  queueDepth( shData *shm , int msgid ) ;
+void wakeSupervisor( shData *shm ) ;
+const char *transportName( int transport ) ;
+int  transportFromName( const char *name ) ;
+
+#endif
@@ -0,0 +1,259 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+#include "workload.h"
+
+#define WL_PI   3.14159265358979323846
+
+static const struct
+{
+    const char *name ;
+    int         minArgs , maxArgs ;
+} distNames[] =
+{
+    [ DIST_CONST ]   = { "const"   , 1 , 1 } ,
+    [ DIST_UNIFORM ] = { "uniform" , 2 , 2 } ,
+    [ DIST_NORMAL ]  = { "normal"  , 2 , 2 } ,
+    [ DIST_BIMODAL ] = { "bimodal" , 4 , 4 } ,
+    [ DIST_PARETO ]  = { "pareto"  , 2 , 3 } ,
+} ;
+
+/*--------------------------------------------------------------------
+   splitmix64: small, fast, and the same on every platform, unlike
+   rand(). Its state is just a counter, so streams are cheap to make.
+----------------------------------------------------------------------*/
+static uint64_t nextRand( uint64_t *s )
+{
+    uint64_t z = ( *s += 0x9E3779B97F4A7C15ULL ) ;
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL ;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL ;
+    return z ^ ( z >> 31 ) ;
+}
+
+// Uniform in (0, 1), never exactly 0 so it is safe to take a log of
+static double nextUnit( uint64_t *s )
+{
+    return ( ( nextRand( s ) >> 11 ) + 0.5 ) / 9007199254740992.0 ;
+}
+
+// Box-Muller; the second value is thrown away to keep draws per
+// factory a fixed count
+static double nextNormal( uint64_t *s , double mean , double sd )
+{
+    double u = nextUnit( s ) , v = nextUnit( s ) ;
+    return mean + sd * sqrt( -2.0 * log( u ) ) * cos( 2.0 * WL_PI * v ) ;
+}
+
+/*--------------------------------------------------------------------
+   One draw from 'd', rounded, at least 1
+----------------------------------------------------------------------*/
+static int draw( const workDist *d , uint64_t *s )
+{
+    const double *p = d->p ;
+    double x ;
+
+    switch ( d->kind )
+    {
+    case DIST_UNIFORM:
+        x = p[0] + (double) ( nextRand( s ) % (uint64_t) ( p[1] - p[0] + 1 ) ) ;
+        break ;
+    case DIST_NORMAL:
+        x = nextNormal( s , p[0] , p[1] ) ;
+        break ;
+    case DIST_BIMODAL:
+        x = nextUnit( s ) < p[3] ? nextNormal( s , p[0] , p[2] ) : nextNormal( s , p[1] , p[2] ) ;
+        break ;
+    case DIST_PARETO:
+        x = p[0] / pow( nextUnit( s ) , 1.0 / p[1] ) ;
+        if ( p[2] > 0 && x > p[2] )
+            x = p[2] ;
+        break ;
+    default:
+        x = p[0] ;
+    }
+
+    if ( x < 1 )
+        return 1 ;
+    if ( x > INT_MAX / 2 )
+        return INT_MAX / 2 ;
+    return (int) lround( x ) ;
+}
+
+/*--------------------------------------------------------------------
+   What Sales always did: capacity 10 .. 50, duration 500 .. 1200 ms,
+   now from 'seed' instead of rand()
+----------------------------------------------------------------------*/
+void workloadDefault( workload *w , uint64_t seed )
+{
+    memset( w , 0 , sizeof( *w ) ) ;
+    w->seed = seed ;
+    w->capacity = (workDist) { DIST_UNIFORM , { 10 , 50 } } ;
+    w->duration = (workDist) { DIST_UNIFORM , { 500 , 1200 } } ;
+}
+
+/*--------------------------------------------------------------------
+   Parse "<name> <params...>" at 'p' into 'd'. Returns 0, or -1.
+----------------------------------------------------------------------*/
+static int parseDist( char *p , workDist *d )
+{
+    char *name = strtok( p , " \t\n" ) , *tok ;
+    if ( name == NULL )
+        return -1 ;
+
+    for ( int k = DIST_CONST ; k <= DIST_PARETO ; k++ )
+    {
+        if ( strcmp( name , distNames[k].name ) != 0 )
+            continue ;
+
+        int n = 0 ;
+        memset( d , 0 , sizeof( *d ) ) ;
+        d->kind = k ;
+        while ( ( tok = strtok( NULL , " \t\n" ) ) != NULL )
+        {
+            char *end ;
+            if ( n == 4 )
+                return -1 ;
+            d->p[ n++ ] = strtod( tok , &end ) ;
+            if ( *end != '\0' )
+                return -1 ;
+        }
+        if ( n < distNames[k].minArgs || n > distNames[k].maxArgs )
+            return -1 ;
+
+        // Parameters that would draw nothing sensible
+        switch ( k )
+        {
+        case DIST_UNIFORM:
+            return ( d->p[0] < 1 || d->p[1] < d->p[0] ) ? -1 : 0 ;
+        case DIST_NORMAL:
+            return d->p[1] < 0 ? -1 : 0 ;
+        case DIST_BIMODAL:
+            return ( d->p[2] < 0 || d->p[3] < 0 || d->p[3] > 1 ) ? -1 : 0 ;
+        case DIST_PARETO:
+            return ( d->p[0] <= 0 || d->p[1] <= 0 ) ? -1 : 0 ;
+        default:
+            return 0 ;
+        }
+    }
+    return -1 ;
+}
+
+/*--------------------------------------------------------------------
+   Read the spec at 'path' over whatever 'w' already holds. Returns 0,
+   or -1 after saying which line was wrong.
+----------------------------------------------------------------------*/
+int workloadLoad( workload *w , const char *path )
+{
+    FILE *in = fopen( path , "r" ) ;
+    if ( in == NULL )
+    {
+        perror( path ) ;
+        return -1 ;
+    }
+
+    char line[ 256 ] ;
+    int  lineNo = 0 , rc = 0 ;
+    while ( rc == 0 && fgets( line , sizeof( line ) , in ) )
+    {
+        char orig[ sizeof( line ) ] ;
+        lineNo++ ;
+        strcpy( orig , line ) ;
+        strtok( orig , "\n" ) ;
+        char *hash = strchr( line , '#' ) ;
+        if ( hash )
+            *hash = '\0' ;
+
+        char key[ 32 ] ;
+        int  used ;
+        if ( sscanf( line , "%31s%n" , key , &used ) != 1 )
+            continue ;
+        char *rest = line + used ;
+
+        unsigned long long v ;
+        int id , cap , dur ;
+        char extra ;
+        if ( strcmp( key , "seed" ) == 0 )
+            rc = ( sscanf( rest , "%llu %c" , &v , &extra ) == 1 ) ? ( w->seed = (uint64_t) v , 0 ) : -1 ;
+        else if ( strcmp( key , "factories" ) == 0 )
+            rc = ( sscanf( rest , "%d %c" , &w->factories , &extra ) == 1 && w->factories > 0 ) ? 0 : -1 ;
+        else if ( strcmp( key , "order" ) == 0 )
+            rc = ( sscanf( rest , "%d %c" , &w->order , &extra ) == 1 && w->order > 0 ) ? 0 : -1 ;
+        else if ( strcmp( key , "capacity" ) == 0 )
+            rc = parseDist( rest , &w->capacity ) ;
+        else if ( strcmp( key , "duration" ) == 0 )
+            rc = parseDist( rest , &w->duration ) ;
+        else if ( strcmp( key , "factory" ) == 0 )
+        {
+            rc = ( sscanf( rest , "%d %d %d %c" , &id , &cap , &dur , &extra ) == 3
+                   && id > 0 && cap > 0 && dur >= 0 ) ? 0 : -1 ;
+            if ( rc == 0 )
+            {
+                workFixed *f = realloc( w->fixed , ( w->nFixed + 1 ) * sizeof( workFixed ) ) ;
+                if ( f == NULL )
+                {
+                    perror( "workload realloc" ) ;
+                    rc = -1 ;
+                    break ;
+                }
+                w->fixed = f ;
+                w->fixed[ w->nFixed++ ] = (workFixed) { id , cap , dur } ;
+            }
+        }
+        else
+            rc = -1 ;
+
+        if ( rc < 0 )
+            fprintf( stderr , "%s:%d: bad workload line '%s'\n" , path , lineNo , orig ) ;
+    }
+
+    fclose( in ) ;
+    return rc ;
+}
+
+/*--------------------------------------------------------------------
+   Capacity and duration of factories 1 .. N. The table wins over the
+   distributions. Returns 0, or -1 if the table names a factory we do
+   not have.
+----------------------------------------------------------------------*/
+int workloadDraw( workload *w , int N , int *capacities , int *durations )
+{
+    for ( int i = 1 ; i <= N ; i++ )
+    {
+        // Factory i's own stream: the seed hashed with its ID
+        uint64_t s = w->seed ^ ( (uint64_t) i * 0xD1B54A32D192ED03ULL ) ;
+        nextRand( &s ) ;
+        capacities[i] = draw( &w->capacity , &s ) ;
+        durations[i]  = draw( &w->duration , &s ) ;
+    }
+
+    for ( int k = 0 ; k < w->nFixed ; k++ )
+    {
+        workFixed *f = &w->fixed[k] ;
+        if ( f->id > N )
+        {
+            fprintf( stderr , "Workload: factory # %d in the table, but only %d factories\n" , f->id , N ) ;
+            return -1 ;
+        }
+        capacities[ f->id ] = f->capacity ;
+        durations[ f->id ]  = f->duration ;
+    }
+    return 0 ;
+}
+
+//------------------
+
+void workloadFree( workload *w )
+{
+    free( w->fixed ) ;
+    w->fixed = NULL ;
+    w->nFixed = 0 ;
+}
@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------
+// Assignment : PA-02 Concurrent Processes & IPC
+// Date       : 10/25/25
+// Author     : Aiden Smith and Braden Drake
+//----------------------------------------------------------------------
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdint.h>
+
+// What Sales gives its factories to do (--workload FILE). A spec is
+// one setting per line, blank lines and '#' comments ignored:
+//
+//   seed      42               draws repeat exactly for the same seed
+//   factories 8                if not given on the command line
+//   order     5000             likewise
+//   capacity  uniform 10 50    parts per batch
+//   duration  normal 850 150   ms per batch
+//   factory   3 50 1200        factory # 3: capacity 50, duration 1200
+//
+// Distributions, every draw rounded and kept at 1 or more:
+//   const V                  always V
+//   uniform LO HI            any integer from LO to HI
+//   normal MEAN SD
+//   bimodal M1 M2 SD FRAC    normal around M1 with probability FRAC,
+//                            else around M2
+//   pareto MIN ALPHA [MAX]   heavy-tailed from MIN, capped at MAX
+//
+// Each factory draws from its own stream of the seed, so factory # i
+// gets the same capacity and duration whatever N is and whichever
+// other factories are in the table.
+typedef enum
+{
+    DIST_CONST = 0 , DIST_UNIFORM , DIST_NORMAL , DIST_BIMODAL , DIST_PARETO
+} dist_t ;
+
+typedef struct
+{
+    int    kind ;               // one of dist_t
+    double p[ 4 ] ;             // its parameters, in the order above
+} workDist ;
+
+typedef struct
+{
+    int id , capacity , duration ;
+} workFixed ;
+
+typedef struct
+{
+    uint64_t   seed ;
+    int        factories , order ;  // 0 when left to the command line
+    workDist   capacity , duration ;
+    workFixed *fixed ;              // the per-factory table
+    int        nFixed ;
+} workload ;
+
+void workloadDefault( workload *w , uint64_t seed ) ;
+int  workloadLoad( workload *w , const char *path ) ;
+int  workloadDraw( workload *w , int N , int *capacities , int *durations ) ;
+void workloadFree( workload *w ) ;
+
+#endif
@@ -9,9 +9,14 @@
 #include <unistd.h>
 #include <errno.h>
 #include <string.h>
+#include <time.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
 #include <sys/msg.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 
 #include "wrappers.h"
 
@@ -61,6 +66,21 @@ int Usleep( useconds_t usec )
 	}
 }
 
+/************************************************
+ * CLOCK_MONOTONIC in nanoseconds. The clock is
+   system-wide, so readings from different processes
+   can be compared
+  ************************************************/
+
+long long Clock_ns( void )
+{
+    struct timespec ts ;
+
+    if ( clock_gettime( CLOCK_MONOTONIC , &ts ) < 0 )
+        unix_error( "clock_gettime() error" ) ;
+    return (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec ;
+}
+
 /************************************************
  * Wrapper for sigaction() 
   ***********************************************/
@@ -101,6 +121,101 @@ int   Msgget( key_t key, int msgflg )
     
 }
 
+/******************************************
+ * Wrappers for Linux futexes
+ * These are deliberately not FUTEX_PRIVATE so that they work on
+ * words living in a shared memory segment used by many processes
+ ******************************************/
+
+int   Futex_wait( int *uaddr, int val )
+{
+    // EAGAIN: *uaddr already changed, EINTR: a signal arrived.
+    // Both just mean "go re-check your condition"
+    if ( syscall( SYS_futex , uaddr , FUTEX_WAIT , val , NULL , NULL , 0 ) < 0 )
+    {
+        if ( errno == EAGAIN || errno == EINTR )
+            return 0 ;
+        unix_error( "futex wait failed" ) ;
+    }
+    return 0 ;
+}
+
+//------------------
+
+// The same, giving up after 'ns' nanoseconds (ETIMEDOUT)
+int   Futex_waitFor( int *uaddr, int val, long long ns )
+{
+    struct timespec t = { ns / 1000000000LL , ns % 1000000000LL } ;
+
+    if ( syscall( SYS_futex , uaddr , FUTEX_WAIT , val , &t , NULL , 0 ) < 0 )
+    {
+        if ( errno == EAGAIN || errno == EINTR || errno == ETIMEDOUT )
+            return 0 ;
+        unix_error( "futex wait failed" ) ;
+    }
+    return 0 ;
+}
+
+//------------------
+
+int   Futex_wake( int *uaddr, int count )
+{
+    int n ;
+
+    n = syscall( SYS_futex , uaddr , FUTEX_WAKE , count , NULL , NULL , 0 ) ;
+    if ( n < 0 )
+        unix_error( "futex wake failed" ) ;
+    return n ;
+}
+
+/******************************************
+ * Wrappers for event-driven waiting
+ ******************************************/
+
+int  Eventfd( unsigned int initval, int flags )
+{
+    int fd = eventfd( initval , flags ) ;
+    if ( fd < 0 )
+        unix_error( "eventfd failed" ) ;
+    return fd ;
+}
+
+//------------------
+
+int  Epoll_create( void )
+{
+    int ep = epoll_create1( EPOLL_CLOEXEC ) ;
+    if ( ep < 0 )
+        unix_error( "epoll_create1 failed" ) ;
+    return ep ;
+}
+
+//------------------
+// Watch 'fd' for input; 'tag' comes back in the event's data.u32
+
+void  Epoll_add( int ep, int fd, unsigned int tag )
+{
+    struct epoll_event ev ;
+
+    memset( &ev , 0 , sizeof( ev ) ) ;
+    ev.events = EPOLLIN ;
+    ev.data.u32 = tag ;
+    if ( epoll_ctl( ep , EPOLL_CTL_ADD , fd , &ev ) < 0 )
+        unix_error( "epoll_ctl failed" ) ;
+}
+
+//------------------
+// A pidfd for 'pid', or -1 if that process is already gone or we are
+// out of descriptors (errno tells which)
+
+int  Pidfd_open( pid_t pid )
+{
+    int fd = syscall( SYS_pidfd_open , pid , 0 ) ;
+    if ( fd < 0 && errno != ESRCH && errno != EMFILE && errno != ENFILE )
+        unix_error( "pidfd_open failed" ) ;
+    return fd ;
+}
+
 /******************************************
  * Wrappers for System V Shared Memory
  ******************************************/
@@ -170,6 +285,24 @@ int  Sem_wait( sem_t *sem )
     return code ;
 }
 
+//------------------
+// Like Sem_wait, but returns 1 if the semaphore was taken and we had
+// to block for it, 0 if it was free
+
+int  Sem_waitCounted( sem_t *sem ) 
+{
+    while ( sem_trywait(sem) != 0 )
+    {
+        if ( errno == EINTR )
+            continue ;
+        if ( errno != EAGAIN )
+            unix_error( "Sem_trywait error" ) ;
+        Sem_wait( sem ) ;
+        return 1 ;
+    }
+    return 0 ;
+}
+
 //------------------
 
 int  Sem_post( sem_t *sem ) 
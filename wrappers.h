@@ -13,18 +13,29 @@ void    posix_error(int code, char *msg) ;
 
 pid_t   Fork(void);
 int     Usleep( useconds_t usec );
+long long Clock_ns( void );
 
 typedef void Sigfunc( int ) ;
 Sigfunc * sigactionWrapper( int signo, Sigfunc *func ) ;
 
 int     Msgget( key_t key, int msgflg );
 
+int     Futex_wait( int *uaddr, int val );
+int     Futex_waitFor( int *uaddr, int val, long long ns );
+int     Futex_wake( int *uaddr, int count );
+
+int     Eventfd( unsigned int initval, int flags );
+int     Epoll_create( void );
+void    Epoll_add( int ep, int fd, unsigned int tag );
+int     Pidfd_open( pid_t pid );
+
 int     Shmget( key_t key, size_t size, int shmflg );
 void   *Shmat( int shmid, const void *shmaddr, int shmflg );
 int     Shmdt( const void *shmaddr ) ;
 
 void    Sem_init( sem_t *sem, int pshared, unsigned int value ) ;
 int     Sem_wait( sem_t *sem );
+int     Sem_waitCounted( sem_t *sem );
 int     Sem_post( sem_t *sem ) ;
 int     Sem_destroy( sem_t *sem ) ;
 sem_t  *Sem_open( const char *name, int oflag, mode_t mode, unsigned int value );